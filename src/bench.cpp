@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sys/resource.h>
+#include "bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+  // Swallows everything written to it. Used to mute the problems' std::cout output while timing them.
+  struct null_streambuf_t : public std::streambuf {
+    int overflow(int c) override { return traits_type::not_eof(c); }
+
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+  };
+
+  unsigned long long read_cycle_counter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    // No portable cycle counter. Fall back to nanoseconds so the column stays meaningful
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  // Resets the kernel's peak RSS (VmHWM) so the next reading covers a single problem. Linux only; elsewhere the
+  // reading is the process high-water mark.
+  void reset_peak_rss() {
+#if defined(__linux__)
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.is_open()) clear_refs << "5";
+#endif
+  }
+
+  long read_peak_rss_kb() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (getline(status, line)) {
+      if (line.compare(0, 6, "VmHWM:") == 0) {
+        return std::stol(line.substr(6));
+      }
+    }
+#endif
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024;  // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+  }
+
+  // Nearest-rank percentile over sorted samples
+  template<typename T>
+  T percentile(const std::vector<T> &sorted_samples, double p) {
+    auto rank = static_cast<size_t>(std::ceil(p * sorted_samples.size()));
+    if (rank == 0) rank = 1;
+    return sorted_samples[std::min(rank, sorted_samples.size()) - 1];
+  }
+
+  problem_stats_t run_problem(const std::function<void(void)> &problem, int day, int problem_id,
+                              const options_t &options) {
+    for (int i = 0; i < options.warmup; i++) {
+      problem();
+    }
+
+    std::vector<long> wall_samples;
+    std::vector<unsigned long long> cycle_samples;
+    reset_peak_rss();
+    for (int i = 0; i < options.iterations; i++) {
+      auto start_time = std::chrono::steady_clock::now();
+      auto start_cycles = read_cycle_counter();
+      problem();
+      auto end_cycles = read_cycle_counter();
+      auto end_time = std::chrono::steady_clock::now();
+      wall_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+      cycle_samples.push_back(end_cycles - start_cycles);
+    }
+    std::sort(wall_samples.begin(), wall_samples.end());
+    std::sort(cycle_samples.begin(), cycle_samples.end());
+
+    problem_stats_t stats{};
+    stats.day = day;
+    stats.problem = problem_id;
+    stats.iterations = options.iterations;
+    stats.min_ns = wall_samples.front();
+    stats.median_ns = percentile(wall_samples, 0.5);
+    stats.p99_ns = percentile(wall_samples, 0.99);
+    stats.min_cycles = cycle_samples.front();
+    stats.median_cycles = percentile(cycle_samples, 0.5);
+    stats.p99_cycles = percentile(cycle_samples, 0.99);
+    stats.peak_rss_kb = read_peak_rss_kb();
+    return stats;
+  }
+
+  std::vector<problem_stats_t> run(const runner::day_problems_t &days, int day_to_run, const options_t &options) {
+    std::vector<problem_stats_t> results;
+    if (options.iterations < 1) return results;
+
+    // Mute problem output and make interactive problems (day 10) see EOF instead of blocking on the terminal
+    null_streambuf_t null_streambuf;
+    auto *cout_streambuf = std::cout.rdbuf(&null_streambuf);
+    auto cin_state = std::cin.rdstate();
+    std::cin.setstate(std::ios::failbit);
+
+    for (size_t d = 0; d < days.size(); d++) {
+      int day = static_cast<int>(d) + 1;
+      if (day_to_run != -1 && day_to_run != day) continue;
+      auto &problems = days[d];
+      for (size_t p = 0; p < problems.size(); p++) {
+        results.push_back(run_problem(problems[p], day, static_cast<int>(p) + 1, options));
+        // Progress goes to stderr so the report on stdout stays machine-readable
+        std::cerr << "Benchmarked day " << day << " problem " << (p + 1) << std::endl;
+      }
+    }
+
+    std::cin.clear(cin_state);
+    std::cout.rdbuf(cout_streambuf);
+    return results;
+  }
+
+  void write_report(std::ostream &out, const std::vector<problem_stats_t> &stats, output_format_e format) {
+    switch (format) {
+      case output_format_e::csv: {
+        out << "day,problem,iterations,min_ns,median_ns,p99_ns,min_cycles,median_cycles,p99_cycles,peak_rss_kb"
+            << std::endl;
+        for (auto &s : stats) {
+          out << s.day << "," << s.problem << "," << s.iterations << "," << s.min_ns << "," << s.median_ns << ","
+              << s.p99_ns << "," << s.min_cycles << "," << s.median_cycles << "," << s.p99_cycles << ","
+              << s.peak_rss_kb << std::endl;
+        }
+        break;
+      }
+      case output_format_e::json: {
+        out << "[" << std::endl;
+        for (size_t i = 0; i < stats.size(); i++) {
+          auto &s = stats[i];
+          out << "  {\"day\": " << s.day << ", \"problem\": " << s.problem << ", \"iterations\": " << s.iterations
+              << ", \"min_ns\": " << s.min_ns << ", \"median_ns\": " << s.median_ns << ", \"p99_ns\": " << s.p99_ns
+              << ", \"min_cycles\": " << s.min_cycles << ", \"median_cycles\": " << s.median_cycles
+              << ", \"p99_cycles\": " << s.p99_cycles << ", \"peak_rss_kb\": " << s.peak_rss_kb << "}"
+              << (i + 1 < stats.size() ? "," : "") << std::endl;
+        }
+        out << "]" << std::endl;
+        break;
+      }
+    }
+  }
+
+  bool parse_format(const std::string &str, output_format_e &format) {
+    if (str == "csv") {
+      format = output_format_e::csv;
+    } else if (str == "json") {
+      format = output_format_e::json;
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+}
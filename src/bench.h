@@ -0,0 +1,43 @@
+#ifndef ADVENT_OF_CODE_2018_BENCH_H
+#define ADVENT_OF_CODE_2018_BENCH_H
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "runner.h"
+
+namespace bench {
+
+  enum class output_format_e {
+    csv,
+    json,
+  };
+
+  struct options_t {
+    int warmup = 1;
+    int iterations = 5;
+    output_format_e format = output_format_e::csv;
+  };
+
+  struct problem_stats_t {
+    int day;
+    int problem;
+    int iterations;
+    long min_ns, median_ns, p99_ns;
+    unsigned long long min_cycles, median_cycles, p99_cycles;
+    long peak_rss_kb;
+  };
+
+  // Runs every problem of day_to_run (or of all days if day_to_run == -1) options.warmup times untimed and then
+  // options.iterations times timed. Problem output is discarded while benchmarking; write_report prints the returned
+  // stats.
+  std::vector<problem_stats_t> run(const runner::day_problems_t &days, int day_to_run, const options_t &options);
+
+  void write_report(std::ostream &out, const std::vector<problem_stats_t> &stats, output_format_e format);
+
+  bool parse_format(const std::string &str, output_format_e &format);
+
+}
+
+#endif //ADVENT_OF_CODE_2018_BENCH_H
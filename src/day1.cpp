@@ -1,13 +1,11 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
+#include "day1.h"
+#include "input.h"
 
 namespace day1 {
 
   void read_day1_data(std::vector<int> &outdata, const char *filepath) {
-    std::ifstream inputStream(filepath);
+    input::mapped_file_t input(filepath);
+    input::view_istream_t inputStream(input.contents());
     std::istream_iterator<int> inputIterator(inputStream);
     std::copy(inputIterator, std::istream_iterator<int>(), std::back_inserter(outdata));
   }
@@ -55,7 +53,7 @@ namespace day1 {
     assert(get_resulting_frequency(test3) == -6);
 
     std::vector<int> input;
-    read_day1_data(input, "data/day1/problem1/input.txt");
+    read_day1_data(input, input::resolve_path(1, "data/day1/problem1/input.txt"));
     std::cout << "Result : " << get_resulting_frequency(input) << std::endl;
 
 #endif
@@ -82,7 +80,7 @@ namespace day1 {
     assert(get_first_repeating_frequency(test4) == 14);
 
     std::vector<int> input;
-    read_day1_data(input, "data/day1/problem2/input.txt");
+    read_day1_data(input, input::resolve_path(1, "data/day1/problem2/input.txt"));
     std::cout << "Result : " << get_first_repeating_frequency(input) << std::endl;
 
 #endif
@@ -0,0 +1,26 @@
+#ifndef ADVENT_OF_CODE_2018_DAY1_H
+#define ADVENT_OF_CODE_2018_DAY1_H
+
+#include <iterator>
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+namespace day1 {
+
+  void read_day1_data(std::vector<int> &outdata, const char *filepath);
+
+  int get_resulting_frequency(std::vector<int> &input);
+
+  int get_first_repeating_frequency(std::vector<int> &input);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY1_H
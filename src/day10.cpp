@@ -1,84 +1,15 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
-#include <list>
-#include <regex>
-#include <limits>
+#include "day10.h"
+#include "input.h"
 
 namespace day10 {
 
-  const bool trace_read = false;
-  const bool trace1 = true;
-
-  struct point_t {
-    long x, y;
-
-    point_t &operator+=(const point_t &other) {
-      x += other.x;
-      y += other.y;
-      return *this;
-    }
-
-    point_t operator*(long value) {
-      point_t result = *this;
-      result.x *= value;
-      result.y *= value;
-      return result;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, point_t &pl) {
-      out << "(" << pl.x << ", " << pl.y << ")";
-      return out;
-    }
-  };
-
-  struct point_of_light_t {
-    point_t initial_position;
-    point_t velocity;
-    point_t current_position;
-
-    point_of_light_t() {}
-
-    point_of_light_t(point_t initial_position, point_t velocity) : initial_position(initial_position),
-                                                                   velocity(velocity),
-                                                                   current_position(initial_position) {}
-
-    friend std::istream &operator>>(std::istream &in, point_of_light_t &pl) {
-      // E.g.: position=< 9,  1> velocity=< 0,  2>
-      std::string line;
-      getline(in, line);
-
-      std::regex light_pattern(R"(position=<\s*(-?\d+),\s*(-?\d+)> velocity=<\s*(-?\d+),\s*(-?\d+)>)");
-      std::smatch light_matches;
-
-      if (!std::regex_search(line, light_matches, light_pattern)) {
-        throw new std::invalid_argument("Cannot parse step rule!");
-      }
-
-      pl.initial_position.x = std::stoi(light_matches[1].str());
-      pl.initial_position.y = std::stoi(light_matches[2].str());
-      pl.velocity.x = std::stoi(light_matches[3].str());
-      pl.velocity.y = std::stoi(light_matches[4].str());
-      pl.current_position = pl.initial_position;
-
-      if (trace_read) std::cout << "Read " << pl << std::endl;
-      return in;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, point_of_light_t &pl) {
-      out << "position=<" << pl.initial_position.x << ", " << pl.initial_position.y << "> velocity=<" << pl.velocity.x
-          << ", " << pl.velocity.y << ">, current=<" << pl.current_position.x << ", " << pl.current_position.y << ">";
-      return out;
-    }
-  };
-
   void read_day10_data(std::vector<point_of_light_t> &outdata, const char *filepath) {
-    std::ifstream input_stream(filepath);
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::string_view line;
     point_of_light_t point_of_light;
-    while (!input_stream.eof()) {
-      input_stream >> point_of_light;
+    while (input::next_line(text, line)) {
+      parse(line, point_of_light);
       outdata.push_back(point_of_light);
     }
   }
@@ -189,7 +120,7 @@ namespace day10 {
 
 
     std::vector<point_of_light_t> input;
-    read_day10_data(input, "data/day10/problem1/input.txt");
+    read_day10_data(input, input::resolve_path(10, "data/day10/problem1/input.txt"));
     int total_time_steps = 0;
 
     time_steps = find_time_step_for_smallest_dimension(input);
@@ -201,7 +132,10 @@ namespace day10 {
     while (command != 'q') {
       render_output(input, 80, 80);
       std::cout << "Next command (q:quit, c:force +1 timestep and continue): ";
-      std::cin >> command;
+      if (!(std::cin >> command)) {
+        // No interactive input (EOF or a non-interactive run). Stop here
+        break;
+      }
 
       switch (command) {
         case 'c': {
@@ -0,0 +1,93 @@
+#ifndef ADVENT_OF_CODE_2018_DAY10_H
+#define ADVENT_OF_CODE_2018_DAY10_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <limits>
+#include "scanner.h"
+
+namespace day10 {
+
+  const bool trace_read = false;
+  const bool trace1 = true;
+
+  struct point_t {
+    long x, y;
+
+    point_t &operator+=(const point_t &other) {
+      x += other.x;
+      y += other.y;
+      return *this;
+    }
+
+    point_t operator*(long value) {
+      point_t result = *this;
+      result.x *= value;
+      result.y *= value;
+      return result;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, point_t &pl) {
+      out << "(" << pl.x << ", " << pl.y << ")";
+      return out;
+    }
+  };
+
+  struct point_of_light_t {
+    point_t initial_position;
+    point_t velocity;
+    point_t current_position;
+
+    point_of_light_t() {}
+
+    point_of_light_t(point_t initial_position, point_t velocity) : initial_position(initial_position),
+                                                                   velocity(velocity),
+                                                                   current_position(initial_position) {}
+
+    friend void parse(std::string_view line, point_of_light_t &pl) {
+      // E.g.: position=< 9,  1> velocity=< 0,  2>
+
+      scanner::scanner_t scan(line);
+      if (!(scan.literal("position=<") && scan.number(pl.initial_position.x) && scan.literal(",") &&
+            scan.number(pl.initial_position.y) && scan.literal("> velocity=<") && scan.number(pl.velocity.x) &&
+            scan.literal(",") && scan.number(pl.velocity.y) && scan.literal(">"))) {
+        throw new std::invalid_argument("Cannot parse step rule!");
+      }
+      pl.current_position = pl.initial_position;
+
+      if (trace_read) std::cout << "Read " << pl << std::endl;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, point_of_light_t &pl) {
+      out << "position=<" << pl.initial_position.x << ", " << pl.initial_position.y << "> velocity=<" << pl.velocity.x
+          << ", " << pl.velocity.y << ">, current=<" << pl.current_position.x << ", " << pl.current_position.y << ">";
+      return out;
+    }
+  };
+
+  void read_day10_data(std::vector<point_of_light_t> &outdata, const char *filepath);
+
+  std::pair<point_t, point_t> compute_enclosing_area_coords(const std::vector<point_of_light_t> &points);
+
+  long compute_enclosing_area(const std::vector<point_of_light_t> &points);
+
+  void move_points(std::vector<point_of_light_t> &points, int time_steps);
+
+  void move_points_one_timestamp(std::vector<point_of_light_t> &points);
+
+  int find_time_step_for_smallest_dimension(const std::vector<point_of_light_t> &input);
+
+  void render_output(const std::vector<point_of_light_t> &input, int swidth, int sheight);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY10_H
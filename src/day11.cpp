@@ -1,145 +1,73 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
-#include <list>
-#include <regex>
-#include <limits>
-#include <array>
+#include "day11.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define DAY11_HAVE_AVX2_PATH 1
+#endif
 
 namespace day11 {
 
-  const bool trace_read = false;
-  const bool trace1 = false;
-  const bool trace2 = false;
-  const bool enable_assertions = false;
-
-  struct max_power_coord_t {
-    int x, y;
-    int power_level;
-  };
-
-  struct max_window_and_coord_t {
-    int x, y;
-    int window_sz;
-  };
-
-  template<int serial_number>
-  struct fuel_cell_t {
-    int x;
-    int y;
-    int power_level;
-
-    void initialize(int _x, int _y) {
-      x = _x;
-      y = _y;
-      power_level = compute_power_level();
+  int window_row_max_scalar(const int *hi_bottom, const int *lo_bottom, const int *hi_above, const int *lo_above,
+                            int n, int start, int best) {
+    for (int i = start; i < n; i++) {
+      best = std::max(best, hi_bottom[i] - lo_bottom[i] - hi_above[i] + lo_above[i]);
     }
+    return best;
+  }
 
-    int get_rack_id() { return x + 10; }
-
-    int compute_power_level() {
-      // std::cout << "Compute " << x << ", " << y << std::endl;
-      int power_level = get_rack_id() * y;
-      power_level += serial_number;
-      power_level *= get_rack_id();
-
-      int div_100 = power_level / 100;
-      int hundreds_digit = div_100 % 10;
-      power_level = hundreds_digit;
-
-      power_level -= 5;
-
-      return power_level;
+#ifdef DAY11_HAVE_AVX2_PATH
+  // Built for AVX2 regardless of the compiler flags; only called after checking the CPU supports it
+  __attribute__((target("avx2")))
+  int window_row_max_avx2(const int *hi_bottom, const int *lo_bottom, const int *hi_above, const int *lo_above, int n) {
+    __m256i best = _mm256_set1_epi32(std::numeric_limits<int>::min());
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+      __m256i power = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(hi_bottom + i)),
+                                       _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lo_bottom + i)));
+      power = _mm256_sub_epi32(power, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(hi_above + i)));
+      power = _mm256_add_epi32(power, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lo_above + i)));
+      best = _mm256_max_epi32(best, power);
     }
-  };
-
-  template<int serial_number>
-  struct fuel_cell_grid_t {
-    std::array<std::array<fuel_cell_t<serial_number>, 300>, 300> fuel_cells;
-
-    std::vector<std::array<std::array<int, 300>, 300>> power_total_cache;
-    std::vector<std::array<std::array<bool, 300>, 300>> power_total_cache_calc_bit;
+    // Reduce the 8 lanes
+    __m128i half = _mm_max_epi32(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    return window_row_max_scalar(hi_bottom, lo_bottom, hi_above, lo_above, n, i, _mm_cvtsi128_si32(half));
+  }
 
-    void initialize() {
-      for (int y = 0; y < 300; y++) {
-        for (int x = 0; x < 300; x++) {
-          fuel_cells[y][x].initialize(x + 1, y + 1);
-        }
-      }
+  const bool cpu_has_avx2 = __builtin_cpu_supports("avx2");
+#endif
 
-      power_total_cache.resize(300);
-      power_total_cache_calc_bit.resize(300);
-    }
+  int window_row_max(const int *hi_bottom, const int *lo_bottom, const int *hi_above, const int *lo_above, int n) {
+#ifdef DAY11_HAVE_AVX2_PATH
+    if (cpu_has_avx2) return window_row_max_avx2(hi_bottom, lo_bottom, hi_above, lo_above, n);
+#endif
+    return window_row_max_scalar(hi_bottom, lo_bottom, hi_above, lo_above, n, 0, std::numeric_limits<int>::min());
+  }
 
-    max_power_coord_t find_coord_of_largest_total_power(int window_sz) {
-      max_power_coord_t result;
-      int max_power = std::numeric_limits<int>::min();
-      int max_d = 300 - window_sz + 1;
-      int window_sz_idx = window_sz - 1;
-
-      for (int y = 0; y < max_d; y++) {
-        for (int x = 0; x < max_d; x++) {
-
-          int power = 0;
-
-          if (power_total_cache_calc_bit[window_sz_idx][y][x]) {
-            power = power_total_cache[window_sz_idx][y][x];
-          } else {
-            // If we have cached value for window_sz_idx - 1
-            if (window_sz_idx > 0 && power_total_cache_calc_bit[window_sz_idx - 1][y][x]) {
-              power = power_total_cache[window_sz_idx - 1][y][x];
-              // Add totals from right and bottom perimeter
-              for (int j = 0; j < window_sz; j++) {
-                power += fuel_cells[y + j][x + window_sz_idx].power_level;
-              }
-              for (int i = 0; i < (window_sz - 1); i++) { // Skip last cell (already added in vertical scan above)
-                power += fuel_cells[y + window_sz_idx][x + i].power_level;
-              }
-            } else {
-              // Do full computation
-              for (int j = 0; j < window_sz; j++) {
-                for (int i = 0; i < window_sz; i++) {
-                  power += fuel_cells[y + j][x + i].power_level;
-                }
-              }
-            }
-
-            power_total_cache[window_sz_idx][y][x] = power;
-            power_total_cache_calc_bit[window_sz_idx][y][x] = true;
-          }
-
-          if (power > max_power) {
-            max_power = power;
-            result = {x + 1, y + 1, power};
-          }
+  std::vector<max_window_and_coord_t> find_coord_and_window_of_largest_total_power(
+    const std::vector<int> &serial_numbers, int dim, unsigned num_threads) {
+    std::vector<max_window_and_coord_t> results(serial_numbers.size());
+    if (serial_numbers.empty()) return results;
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads > serial_numbers.size()) num_threads = static_cast<unsigned>(serial_numbers.size());
+
+    const power_base_t base(dim);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < num_threads; t++) {
+      workers.emplace_back([&, t]() {
+        summed_area_grid_t grid;
+        for (size_t i = t; i < serial_numbers.size(); i += num_threads) {
+          grid.initialize(base, serial_numbers[i]);
+          results[i] = grid.find_coord_and_window_of_largest_total_power();
         }
-      }
-
-      if (trace1)
-        std::cout << "Coord for window " << window_sz << ": " << result.x << "," << result.y << " ("
-                  << result.power_level << ")" << std::endl;
-      return result;
+      });
     }
-
-    max_window_and_coord_t find_coord_and_window_of_largest_total_power() {
-      max_window_and_coord_t result;
-      int max_power = std::numeric_limits<int>::min();
-      for (int window_sz = 1; window_sz <= 300; window_sz++) {
-        auto max_coord = find_coord_of_largest_total_power(window_sz);
-        if (max_coord.power_level > max_power) {
-          max_power = max_coord.power_level;
-          result.window_sz = window_sz;
-          result.x = max_coord.x;
-          result.y = max_coord.y;
-        }
-      }
-      if (trace2)
-        std::cout << "Max window and coord: " << result.x << "," << result.y << "," << result.window_sz << std::endl;
-      return result;
+    for (auto &w : workers) {
+      w.join();
     }
-  };
+    return results;
+  }
 
   void problem1() {
     std::cout << "Day 11 - Problem 1" << std::endl;
@@ -161,12 +89,34 @@ namespace day11 {
 
       fuel_cell_grid_t<18> grid_18;
       grid_18.initialize();
-      auto max_coord_18 = grid_18.find_coord_of_largest_total_power(3);
+      [[maybe_unused]] auto max_coord_18 = grid_18.find_coord_of_largest_total_power(3);
       assert(max_coord_18.x == 33 && max_coord_18.y == 45);
     }
 
-    fuel_cell_grid_t<2866> grid_result;
-    grid_result.initialize();
+    // The summed-area table is quick enough to always check
+    summed_area_grid_t summed_18;
+    summed_18.initialize(18);
+    assert(summed_18.total_power(33, 45, 3) == 29);
+    [[maybe_unused]] auto summed_max_coord_18 = summed_18.find_coord_of_largest_total_power(3);
+    assert(summed_max_coord_18.x == 33 && summed_max_coord_18.y == 45);
+
+    summed_area_grid_t grid_result;
+    grid_result.initialize(2866);
+
+    // The vectorized row maximum must agree with the scalar one, tails shorter than a vector included
+    for (int window_sz = 1; window_sz <= 20; window_sz++) {
+      for (int y = 1; y <= grid_result.dim - window_sz + 1; y++) {
+        const int *above = grid_result.sums.row(y - 2);
+        const int *bottom = grid_result.sums.row(y + window_sz - 2);
+        int n = grid_result.dim - window_sz + 1;
+        [[maybe_unused]] int vectorized = window_row_max(bottom + window_sz - 1, bottom - 1, above + window_sz - 1,
+                                                         above - 1, n);
+        [[maybe_unused]] int scalar = window_row_max_scalar(bottom + window_sz - 1, bottom - 1, above + window_sz - 1,
+                                                            above - 1, n, 0, std::numeric_limits<int>::min());
+        assert(vectorized == scalar);
+      }
+    }
+
     auto max_coord = grid_result.find_coord_of_largest_total_power(3);
     std::cout << "Result: " << max_coord.x << "," << max_coord.y << std::endl;
 
@@ -177,23 +127,41 @@ namespace day11 {
     std::cout << "Day 11 - Problem 2" << std::endl;
 #if !defined(ONLY_ACTIVATE) || ONLY_ACTIVATE == 11
 
+    // The summed-area table is quick enough to always check
+    summed_area_grid_t summed_18;
+    summed_18.initialize(18);
+    [[maybe_unused]] auto summed_coord_and_window_18 = summed_18.find_coord_and_window_of_largest_total_power();
+    assert(summed_coord_and_window_18.x == 90 && summed_coord_and_window_18.y == 269 &&
+           summed_coord_and_window_18.window_sz == 16);
+    [[maybe_unused]] auto parallel_coord_and_window_18 =
+      summed_18.find_coord_and_window_of_largest_total_power_parallel(3);
+    assert(parallel_coord_and_window_18.x == 90 && parallel_coord_and_window_18.y == 269 &&
+           parallel_coord_and_window_18.window_sz == 16);
+    [[maybe_unused]] auto batch_results = find_coord_and_window_of_largest_total_power({18, 42});
+    assert(batch_results[0].x == 90 && batch_results[0].y == 269 && batch_results[0].window_sz == 16);
+    assert(batch_results[1].x == 232 && batch_results[1].y == 251 && batch_results[1].window_sz == 12);
+
     if (enable_assertions) {
       fuel_cell_grid_t<18> grid_18;
       grid_18.initialize();
-      auto max_coord_and_window_18 = grid_18.find_coord_and_window_of_largest_total_power();
+      [[maybe_unused]] auto max_coord_and_window_18 = grid_18.find_coord_and_window_of_largest_total_power();
       assert(
         max_coord_and_window_18.x == 90 && max_coord_and_window_18.y == 269 && max_coord_and_window_18.window_sz == 16);
 
       fuel_cell_grid_t<42> grid_42;
       grid_42.initialize();
-      auto max_coord_and_window_42 = grid_42.find_coord_and_window_of_largest_total_power();
+      [[maybe_unused]] auto max_coord_and_window_42 = grid_42.find_coord_and_window_of_largest_total_power();
       assert(max_coord_and_window_42.x == 232 && max_coord_and_window_42.y == 251 &&
              max_coord_and_window_42.window_sz == 12);
     }
 
-    fuel_cell_grid_t<2866> grid_result;
-    grid_result.initialize();
-    auto max_coord_and_window_result = grid_result.find_coord_and_window_of_largest_total_power();
+    summed_area_grid_t grid_result;
+    grid_result.initialize(2866);
+    auto max_coord_and_window_result = grid_result.find_coord_and_window_of_largest_total_power_parallel();
+    [[maybe_unused]] auto serial_coord_and_window_result = grid_result.find_coord_and_window_of_largest_total_power();
+    assert(max_coord_and_window_result.x == serial_coord_and_window_result.x &&
+           max_coord_and_window_result.y == serial_coord_and_window_result.y &&
+           max_coord_and_window_result.window_sz == serial_coord_and_window_result.window_sz);
     std::cout << "Result: " << max_coord_and_window_result.x << "," << max_coord_and_window_result.y << ","
               << max_coord_and_window_result.window_sz << std::endl;
 
@@ -0,0 +1,297 @@
+#ifndef ADVENT_OF_CODE_2018_DAY11_H
+#define ADVENT_OF_CODE_2018_DAY11_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <regex>
+#include <limits>
+#include <array>
+#include <thread>
+#include "grid2d.h"
+
+namespace day11 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+  const bool enable_assertions = false;
+
+  struct max_power_coord_t {
+    int x, y;
+    int power_level;
+  };
+
+  struct max_window_and_coord_t {
+    int x, y;
+    int window_sz;
+  };
+
+  // Power level of the fuel cell at (x, y) (1-based) for a grid serial number
+  inline int compute_power_level(int x, int y, int serial_number) {
+    long rack_id = x + 10;
+    long power_level = (rack_id * y + serial_number) * rack_id;
+    return static_cast<int>(power_level / 100 % 10) - 5;
+  }
+
+  template<int serial_number>
+  struct fuel_cell_t {
+    int x;
+    int y;
+    int power_level;
+
+    void initialize(int _x, int _y) {
+      x = _x;
+      y = _y;
+      power_level = compute_power_level();
+    }
+
+    int get_rack_id() { return x + 10; }
+
+    int compute_power_level() {
+      // std::cout << "Compute " << x << ", " << y << std::endl;
+      return day11::compute_power_level(x, y, serial_number);
+    }
+  };
+
+  template<int serial_number>
+  struct fuel_cell_grid_t {
+    std::array<std::array<fuel_cell_t<serial_number>, 300>, 300> fuel_cells;
+
+    std::vector<std::array<std::array<int, 300>, 300>> power_total_cache;
+    std::vector<std::array<std::array<bool, 300>, 300>> power_total_cache_calc_bit;
+
+    void initialize() {
+      for (int y = 0; y < 300; y++) {
+        for (int x = 0; x < 300; x++) {
+          fuel_cells[y][x].initialize(x + 1, y + 1);
+        }
+      }
+
+      power_total_cache.resize(300);
+      power_total_cache_calc_bit.resize(300);
+    }
+
+    max_power_coord_t find_coord_of_largest_total_power(int window_sz) {
+      max_power_coord_t result;
+      int max_power = std::numeric_limits<int>::min();
+      int max_d = 300 - window_sz + 1;
+      int window_sz_idx = window_sz - 1;
+
+      for (int y = 0; y < max_d; y++) {
+        for (int x = 0; x < max_d; x++) {
+
+          int power = 0;
+
+          if (power_total_cache_calc_bit[window_sz_idx][y][x]) {
+            power = power_total_cache[window_sz_idx][y][x];
+          } else {
+            // If we have cached value for window_sz_idx - 1
+            if (window_sz_idx > 0 && power_total_cache_calc_bit[window_sz_idx - 1][y][x]) {
+              power = power_total_cache[window_sz_idx - 1][y][x];
+              // Add totals from right and bottom perimeter
+              for (int j = 0; j < window_sz; j++) {
+                power += fuel_cells[y + j][x + window_sz_idx].power_level;
+              }
+              for (int i = 0; i < (window_sz - 1); i++) { // Skip last cell (already added in vertical scan above)
+                power += fuel_cells[y + window_sz_idx][x + i].power_level;
+              }
+            } else {
+              // Do full computation
+              for (int j = 0; j < window_sz; j++) {
+                for (int i = 0; i < window_sz; i++) {
+                  power += fuel_cells[y + j][x + i].power_level;
+                }
+              }
+            }
+
+            power_total_cache[window_sz_idx][y][x] = power;
+            power_total_cache_calc_bit[window_sz_idx][y][x] = true;
+          }
+
+          if (power > max_power) {
+            max_power = power;
+            result = {x + 1, y + 1, power};
+          }
+        }
+      }
+
+      if (trace1)
+        std::cout << "Coord for window " << window_sz << ": " << result.x << "," << result.y << " ("
+                  << result.power_level << ")" << std::endl;
+      return result;
+    }
+
+    max_window_and_coord_t find_coord_and_window_of_largest_total_power() {
+      max_window_and_coord_t result;
+      int max_power = std::numeric_limits<int>::min();
+      for (int window_sz = 1; window_sz <= 300; window_sz++) {
+        auto max_coord = find_coord_of_largest_total_power(window_sz);
+        if (max_coord.power_level > max_power) {
+          max_power = max_coord.power_level;
+          result.window_sz = window_sz;
+          result.x = max_coord.x;
+          result.y = max_coord.y;
+        }
+      }
+      if (trace2)
+        std::cout << "Max window and coord: " << result.x << "," << result.y << "," << result.window_sz << std::endl;
+      return result;
+    }
+  };
+
+  // Largest of hi_bottom[i] - lo_bottom[i] - hi_above[i] + lo_above[i] for i in [0, n), i.e. the best window total
+  // along one row of a summed-area table. Uses AVX2 when the CPU has it.
+  int window_row_max(const int *hi_bottom, const int *lo_bottom, const int *hi_above, const int *lo_above, int n);
+
+  // The serial-independent part of every power level in a dim x dim grid: power is
+  // ((rack_id^2 * y + serial_number * rack_id) / 100) % 10 - 5, so rack_id^2 * y is computed once and shared by every
+  // serial number evaluated on the grid.
+  struct power_base_t {
+    int dim = 0;
+    std::vector<long> rack_ids;           // By x - 1
+    grid2d::grid2d_t<long> rack_id_sq_y;  // At (x - 1, y - 1)
+
+    explicit power_base_t(int _dim = 300) : dim(_dim), rack_ids(_dim), rack_id_sq_y(_dim, _dim) {
+      for (int x = 1; x <= dim; x++) {
+        rack_ids[x - 1] = x + 10;
+      }
+      for (int y = 1; y <= dim; y++) {
+        long *row = rack_id_sq_y.row(y - 1);
+        for (int x = 1; x <= dim; x++) {
+          row[x - 1] = rack_ids[x - 1] * rack_ids[x - 1] * y;
+        }
+      }
+    }
+  };
+
+  // Same searches as fuel_cell_grid_t over a dim x dim grid with a runtime serial number, answered from a summed-area
+  // table: each entry holds the total power of the rectangle from (1, 1) to its cell, so any window total takes 4
+  // lookups. The table is a single (dim + 1)^2 array of int (the border row and column are the zero sums of empty
+  // rectangles).
+  struct summed_area_grid_t {
+    int serial_number = 0;
+    int dim = 0;
+    grid2d::grid2d_t<int> sums;
+
+    void initialize(int _serial_number, int _dim = 300) {
+      initialize(power_base_t(_dim), _serial_number);
+    }
+
+    // Reuses the table storage, so one grid can evaluate many serial numbers in turn
+    void initialize(const power_base_t &base, int _serial_number) {
+      serial_number = _serial_number;
+      dim = base.dim;
+      // Cell (x, y) (1-based) is stored at (x - 1, y - 1), so the padding at -1 holds the empty sums
+      if (sums.width != dim) sums.resize(dim, dim, 1, 0);
+      for (int y = 1; y <= dim; y++) {
+        const long *base_row = base.rack_id_sq_y.row(y - 1);
+        const int *above = sums.row(y - 2);
+        int *current = sums.row(y - 1);
+        int row_total = 0;
+        for (int x = 1; x <= dim; x++) {
+          long power_level = base_row[x - 1] + serial_number * base.rack_ids[x - 1];
+          row_total += static_cast<int>(power_level / 100 % 10) - 5;
+          current[x - 1] = above[x - 1] + row_total;
+        }
+      }
+    }
+
+    // Total power of the window_sz x window_sz square whose top-left cell is (x, y) (1-based)
+    int total_power(int x, int y, int window_sz) const {
+      const int *above = sums.row(y - 2);
+      const int *bottom = sums.row(y + window_sz - 2);
+      return bottom[x + window_sz - 2] - bottom[x - 2] - above[x + window_sz - 2] + above[x - 2];
+    }
+
+    // Scans in the same order as fuel_cell_grid_t, so ties resolve to the same coordinate
+    max_power_coord_t find_coord_of_largest_total_power(int window_sz) const {
+      max_power_coord_t result;
+      int max_power = std::numeric_limits<int>::min();
+      int max_d = dim - window_sz + 1;
+
+      for (int y = 1; y <= max_d; y++) {
+        const int *above = sums.row(y - 2);
+        const int *bottom = sums.row(y + window_sz - 2);
+        int row_max = window_row_max(bottom + window_sz - 1, bottom - 1, above + window_sz - 1, above - 1, max_d);
+        if (row_max > max_power) {
+          // Only the first x reaching the row maximum can be the result
+          int x = 1;
+          while (bottom[x + window_sz - 2] - bottom[x - 2] - above[x + window_sz - 2] + above[x - 2] != row_max) x++;
+          max_power = row_max;
+          result = {x, y, row_max};
+        }
+      }
+
+      if (trace1)
+        std::cout << "Coord for window " << window_sz << ": " << result.x << "," << result.y << " ("
+                  << result.power_level << ")" << std::endl;
+      return result;
+    }
+
+    max_window_and_coord_t find_coord_and_window_of_largest_total_power() const {
+      max_window_and_coord_t result;
+      int max_power = std::numeric_limits<int>::min();
+      for (int window_sz = 1; window_sz <= dim; window_sz++) {
+        auto max_coord = find_coord_of_largest_total_power(window_sz);
+        if (max_coord.power_level > max_power) {
+          max_power = max_coord.power_level;
+          result.window_sz = window_sz;
+          result.x = max_coord.x;
+          result.y = max_coord.y;
+        }
+      }
+      if (trace2)
+        std::cout << "Max window and coord: " << result.x << "," << result.y << "," << result.window_sz << std::endl;
+      return result;
+    }
+
+    // Same result as find_coord_and_window_of_largest_total_power. Window sizes are dealt round-robin to num_threads
+    // workers (0 = one per hardware thread), then the per-size maxima are reduced in window size order.
+    max_window_and_coord_t find_coord_and_window_of_largest_total_power_parallel(unsigned num_threads = 0) const {
+      if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+      if (num_threads > static_cast<unsigned>(dim)) num_threads = std::max(1, dim);
+
+      std::vector<max_power_coord_t> max_coords(dim + 1);
+      std::vector<std::thread> workers;
+      for (unsigned t = 0; t < num_threads; t++) {
+        workers.emplace_back([this, t, num_threads, &max_coords]() {
+          for (int window_sz = 1 + static_cast<int>(t); window_sz <= dim; window_sz += num_threads) {
+            max_coords[window_sz] = find_coord_of_largest_total_power(window_sz);
+          }
+        });
+      }
+      for (auto &w : workers) {
+        w.join();
+      }
+
+      max_window_and_coord_t result;
+      int max_power = std::numeric_limits<int>::min();
+      for (int window_sz = 1; window_sz <= dim; window_sz++) {
+        if (max_coords[window_sz].power_level > max_power) {
+          max_power = max_coords[window_sz].power_level;
+          result = {max_coords[window_sz].x, max_coords[window_sz].y, window_sz};
+        }
+      }
+      if (trace2)
+        std::cout << "Max window and coord: " << result.x << "," << result.y << "," << result.window_sz << std::endl;
+      return result;
+    }
+  };
+
+  // Best window and coordinate for each serial number over a dim x dim grid, in the order given. Serial numbers are
+  // dealt to num_threads workers (0 = one per hardware thread) that share a single power_base_t.
+  std::vector<max_window_and_coord_t> find_coord_and_window_of_largest_total_power(
+    const std::vector<int> &serial_numbers, int dim = 300, unsigned num_threads = 0);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY11_H
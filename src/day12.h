@@ -0,0 +1,362 @@
+#ifndef ADVENT_OF_CODE_2018_DAY12_H
+#define ADVENT_OF_CODE_2018_DAY12_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <limits>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include "scanner.h"
+#include "instrument.h"
+
+namespace day12 {
+
+  const bool trace_read = false;
+  const bool trace1 = true;
+  const bool trace2 = false;
+  const bool enable_assertions = false;
+
+  inline instrument::counter_t generations_run{"day12.generations"};
+  inline instrument::counter_t rules_matched{"day12.rules_matched"};
+
+  const int dim = 1000;
+  const int pot_printer_start_idx = -6;
+  const int pot_printer_end_idx = 240;
+
+  struct next_gen_rule_t {
+    std::array<bool, 5> pattern;
+    bool result;
+
+    friend std::istream &operator>>(std::istream &in, next_gen_rule_t &ngr) {
+      // E.g.: ####. => .
+      // E.g.: ##.#. => #
+      std::string line;
+      getline(in, line);
+
+      scanner::scanner_t scan(line);
+      std::array<char, 5> pattern;
+      char result;
+      if (!(scan.one_of("#.", pattern[0]) && scan.one_of("#.", pattern[1]) && scan.one_of("#.", pattern[2]) &&
+            scan.one_of("#.", pattern[3]) && scan.one_of("#.", pattern[4]) && scan.literal(" => ") &&
+            scan.one_of("#.", result))) {
+        throw new std::invalid_argument("Cannot parse rule!");
+      }
+
+      for (int i = 0; i < 5; i++) {
+        ngr.pattern[i] = (pattern[i] == '#');
+      }
+
+      ngr.result = result == '#';
+
+      if (trace_read) std::cout << "Rule: " << ngr << std::endl;
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, next_gen_rule_t &ngr) {
+      for (auto &p : ngr.pattern) {
+        out << (p ? '#' : '.');
+      }
+      out << " => " << (ngr.result ? '#' : '.');
+      return out;
+    }
+  };
+
+  struct cave_t {
+    // -dim, ..., -1, 0, 1, ..., dim
+    std::array<bool, (dim * 2) + 1> pots{false};
+    int zero_index = dim + 1;
+    std::vector<next_gen_rule_t> next_gen_rules;
+    int generation = 0;
+    std::vector<bool> initial_state;
+
+    void initialize(const std::vector<bool> &_initial_state) {
+      initial_state = _initial_state;
+      assert(initial_state.size() < dim);
+      for (int i = 0; i < initial_state.size(); i++) {
+        pots[zero_index + i] = initial_state[i];
+      }
+    }
+
+    void run_gen() {
+      std::array<bool, (dim * 2) + 1> next_pots = pots;
+      unsigned long long matched_pots = 0;
+
+      for (int i = 2; i < pots.size() - 2; i++) {
+        bool rule_matched = false;
+        for (auto &rule : next_gen_rules) {
+          for (int r = 0; r < rule.pattern.size(); r++) {
+            if (pots[i - 2] == rule.pattern[0] &&
+                pots[i - 1] == rule.pattern[1] &&
+                pots[i] == rule.pattern[2] &&
+                pots[i + 1] == rule.pattern[3] &&
+                pots[i + 2] == rule.pattern[4]) {
+              next_pots[i] = rule.result;
+              rule_matched = true;
+            }
+          }
+          if (rule_matched) {
+            break;
+          }
+        }
+        if (!rule_matched) {    // No rule matched, assume we remove the plant
+          next_pots[i] = false;
+        } else {
+          matched_pots++;
+        }
+      }
+
+      pots = next_pots;
+      generation++;
+      generations_run.add();
+      rules_matched.add(matched_pots);
+    }
+
+    void run(int steps) {
+      for (int i = 0; i < steps; i++) {
+        run_gen();
+        if (trace1) print_pots(pot_printer_start_idx, pot_printer_end_idx);
+      }
+    }
+
+    void print_pots(int start_idx, int end_idx) {
+      std::cout << generation << ": ";
+      for (int i = start_idx; i <= end_idx; i++) {
+        std::cout << (pots[zero_index + i] ? '#' : '.');
+      }
+      std::cout << " (" << sum_of_plant_containing_pots() << ")" << std::endl;
+    }
+
+    int sum_of_plant_containing_pots() {
+      int sum = 0;
+      for (int i = 0; i < pots.size(); i++) {
+        sum += (pots[i] ? (i - zero_index) : 0);
+      }
+      return sum;
+    }
+
+    friend std::istream &operator>>(std::istream &in, cave_t &cave) {
+      // First line is initial state
+      // E.g.: initial state: #..#.#..##......###...###
+      std::string line;
+      getline(in, line);
+
+      scanner::scanner_t scan(line);
+      std::string_view state;
+      if (!(scan.literal("initial state: ") && scan.span_of("#.", state))) {
+        throw new std::invalid_argument("Cannot parse initial state!");
+      }
+      std::vector<bool> initial_state;
+      for (auto &c : state) {
+        if (c == '#') initial_state.push_back(true);
+        else if (c == '.') initial_state.push_back(false);
+        else throw new std::invalid_argument("Unknown initial state value!");
+      }
+      if (trace_read) {
+        std::cout << "initial_state: ";
+        for (auto s : initial_state) {
+          std::cout << (s ? '#' : '.');
+        }
+        std::cout << std::endl;
+      }
+      cave.initialize(initial_state);
+
+      // Skip next line
+      getline(in, line);
+
+      // Process the gen rules
+      next_gen_rule_t next_gen_rule;
+      while (!in.eof()) {
+        in >> next_gen_rule;
+        cave.next_gen_rules.push_back(next_gen_rule);
+      }
+
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, cave_t &cave) {
+      // TODO
+
+      return out;
+    }
+  };
+
+  // Where the plants start and what they look like from there, so states that only differ by a translation compare
+  // equal
+  struct normalized_state_t {
+    long first_pot = 0;
+    long num_plants = 0;
+    std::vector<uint64_t> pattern;  // Bit i is pot first_pot + i
+
+    size_t hash() const {
+      size_t h = 14695981039346656037ull;
+      for (auto word : pattern) {
+        h = (h ^ word) * 1099511628211ull;
+      }
+      return h;
+    }
+  };
+
+  // Same automaton as cave_t with the pots packed 64 to a word and the rules folded into a 32-entry table, indexed by
+  // the 5-bit window around each pot (pot - 2 in bit 4 down to pot + 2 in bit 0). The words cover only the live
+  // range and grow or shrink as the plants move, so there is no fixed pot limit.
+  struct packed_cave_t {
+    std::vector<uint64_t> words;  // Bit b of words[w] is pot origin + 64 * w + b
+    std::vector<uint64_t> next_words;
+    long origin = 0;
+    uint32_t rule_table = 0;      // Bit n set if window n grows a plant
+    long generation = 0;
+
+    void initialize(const cave_t &cave) {
+      rule_table = 0;
+      for (auto &rule : cave.next_gen_rules) {
+        unsigned window = 0;
+        for (bool p : rule.pattern) {
+          window = (window << 1) | (p ? 1 : 0);
+        }
+        if (rule.result) rule_table |= 1u << window;
+      }
+      // A plant growing out of nothing would fill the infinite row
+      if (rule_table & 1) throw new std::invalid_argument("Rule ..... => # is not supported!");
+
+      words.assign((cave.initial_state.size() + 63) / 64 + 1, 0);
+      for (size_t i = 0; i < cave.initial_state.size(); i++) {
+        if (cave.initial_state[i]) words[i / 64] |= uint64_t(1) << (i % 64);
+      }
+      origin = 0;
+      generation = 0;
+    }
+
+    // Keeps 4 empty pots at both ends so every window that can grow a plant lies inside the words
+    void fit_range() {
+      while (words.size() > 1 && words.front() == 0) {
+        words.erase(words.begin());
+        origin += 64;
+      }
+      while (words.size() > 1 && words.back() == 0 && (words[words.size() - 2] >> 60) == 0) {
+        words.pop_back();
+      }
+      if (words.front() & 0xf) {
+        words.insert(words.begin(), 0);
+        origin -= 64;
+      }
+      if (words.back() >> 60) {
+        words.push_back(0);
+      }
+    }
+
+    void run_gen() {
+      fit_range();
+      next_words.assign(words.size(), 0);
+
+      // Slide the window one pot at a time; after taking in pot q it is centred on pot q - 2. Pots below 2 are empty
+      // windows, which never grow a plant.
+      unsigned window = 0;
+      for (size_t w = 0; w < words.size(); w++) {
+        uint64_t word = words[w];
+        for (unsigned b = 0; b < 64; b++) {
+          window = ((window << 1) | ((word >> b) & 1)) & 31;
+          size_t center = 64 * w + b - 2;
+          if ((rule_table >> window) & 1) next_words[center / 64] |= uint64_t(1) << (center % 64);
+        }
+      }
+
+      words.swap(next_words);
+      generation++;
+      generations_run.add();
+    }
+
+    void run(long steps) {
+      for (long i = 0; i < steps; i++) {
+        run_gen();
+        if (trace1) print_pots(pot_printer_start_idx, pot_printer_end_idx);
+      }
+    }
+
+    normalized_state_t normalized() const {
+      normalized_state_t state;
+      size_t w = 0;
+      while (w < words.size() && words[w] == 0) w++;
+      if (w == words.size()) return state;
+
+      unsigned shift = __builtin_ctzll(words[w]);
+      state.first_pot = origin + 64 * static_cast<long>(w) + shift;
+      for (; w < words.size(); w++) {
+        uint64_t word = words[w] >> shift;
+        if (shift > 0 && w + 1 < words.size()) word |= words[w + 1] << (64 - shift);
+        state.pattern.push_back(word);
+        state.num_plants += __builtin_popcountll(words[w]);
+      }
+      while (!state.pattern.empty() && state.pattern.back() == 0) state.pattern.pop_back();
+      return state;
+    }
+
+    // Sum of plant-containing pots at target_generation (>= generation). Runs until the plants repeat a pattern seen
+    // in an earlier generation, shifted or not, then projects the remaining whole periods: each one moves every plant
+    // by the same number of pots. Leaves the cave at the generation where the repeat was found plus the leftover
+    // generations of an incomplete period.
+    long project_sum_of_plant_containing_pots(long target_generation) {
+      std::unordered_map<size_t, size_t> seen;  // Hash to index in history
+      std::vector<normalized_state_t> history;
+
+      while (generation < target_generation) {
+        auto state = normalized();
+        auto found = seen.find(state.hash());
+        if (found != seen.end() && history[found->second].pattern == state.pattern) {
+          auto &earlier = history[found->second];
+          long period = static_cast<long>(history.size() - found->second);
+          long shift = state.first_pot - earlier.first_pot;
+          long periods = (target_generation - generation) / period;
+          if (trace2)
+            std::cout << "Pattern at generation " << generation << " repeats every " << period << " generations, "
+                      << "moving " << shift << " pots" << std::endl;
+          run((target_generation - generation) % period);
+          // The plant count can change within a period, so shift the plants of the generation actually reached
+          return sum_of_plant_containing_pots() + periods * shift * normalized().num_plants;
+        }
+        seen[state.hash()] = history.size();
+        history.push_back(std::move(state));
+        run(1);
+      }
+      return sum_of_plant_containing_pots();
+    }
+
+    bool has_plant(long pot) const {
+      long i = pot - origin;
+      if (i < 0 || i >= static_cast<long>(words.size()) * 64) return false;
+      return (words[i / 64] >> (i % 64)) & 1;
+    }
+
+    void print_pots(long start_idx, long end_idx) const {
+      std::cout << generation << ": ";
+      for (long i = start_idx; i <= end_idx; i++) {
+        std::cout << (has_plant(i) ? '#' : '.');
+      }
+      std::cout << " (" << sum_of_plant_containing_pots() << ")" << std::endl;
+    }
+
+    long sum_of_plant_containing_pots() const {
+      long sum = 0;
+      for (size_t w = 0; w < words.size(); w++) {
+        for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+          sum += origin + 64 * static_cast<long>(w) + __builtin_ctzll(word);
+        }
+      }
+      return sum;
+    }
+  };
+
+  void read_day12_data(cave_t &outdata, const char *filepath);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY12_H
@@ -0,0 +1,628 @@
+#ifndef ADVENT_OF_CODE_2018_DAY13_H
+#define ADVENT_OF_CODE_2018_DAY13_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <regex>
+#include <limits>
+#include <array>
+#include <cstdint>
+#include "grid2d.h"
+#include "input.h"
+#include "instrument.h"
+
+namespace day13 {
+
+  const bool trace_read = false;
+  const bool trace_carts_collisions = true;
+  const bool trace1 = true;
+  const bool trace2 = false;
+  const bool enable_assertions = false;
+
+  inline instrument::counter_t ticks_run{"day13.ticks"};
+  inline instrument::counter_t collisions_detected{"day13.collisions"};
+  inline instrument::timer_stats_t collision_search_timer{"day13.find_collision"};
+
+  enum direction_e {
+    up,
+    right,
+    down,
+    left,
+  };
+
+  enum track_type_e : uint8_t {
+    none,
+    up_down,
+    left_right,
+    up_left,
+    up_right,
+    down_left,
+    down_right,
+    intersection,
+  };
+
+  enum cart_behavior_e {
+    turn_left = 0,
+    go_straight,
+    turn_right,
+
+    sentinel,
+  };
+
+  struct track_t {
+    track_type_e type = track_type_e::none;
+  };
+
+  class cart_t {
+    int x;
+    int y;
+    int direction;
+    int behavior;
+
+  public:
+    void initialize(int _x, int _y, int _direction) {
+      x = _x;
+      y = _y;
+      direction = _direction;
+      behavior = cart_behavior_e::turn_left;
+    }
+
+    void move_to(int _x, int _y, int _direction, bool turned_at_intersection) {
+      x = _x;
+      y = _y;
+      direction = _direction;
+
+      if (turned_at_intersection) {
+        // If turned, incremenent behavior
+        behavior++;
+        if (behavior == cart_behavior_e::sentinel) {
+          behavior = cart_behavior_e::turn_left;
+        }
+      }
+    }
+
+    bool is_at(int _x, int _y) const { return x == _x && y == _y; }
+
+    int get_direction() const { return direction; }
+
+    int get_behavior() const { return behavior; }
+
+    int get_x() const { return x; }
+
+    int get_y() const { return y; }
+
+    bool operator<(const cart_t &other) const {
+      if (y < other.y) return true;
+      else if (y == other.y) {
+        return x < other.x;
+      }
+      return false;
+    }
+  };
+
+  // Direction and intersection behavior of a cart after it enters a track
+  struct transition_t {
+    uint8_t direction;
+    uint8_t behavior;
+  };
+
+  constexpr transition_t compute_transition(track_type_e next_track, int direction, int behavior) {
+    switch (next_track) {
+      case track_type_e::intersection: {
+        int next_behavior = (behavior + 1) % cart_behavior_e::sentinel;
+        int next_direction = direction;
+        if (behavior == cart_behavior_e::turn_left) next_direction = (direction + 3) % 4;
+        else if (behavior == cart_behavior_e::turn_right) next_direction = (direction + 1) % 4;
+        return {static_cast<uint8_t>(next_direction), static_cast<uint8_t>(next_behavior)};
+      }
+      case track_type_e::down_right:
+        if (direction == direction_e::up) direction = direction_e::right;
+        else if (direction == direction_e::left) direction = direction_e::down;
+        break;
+      case track_type_e::down_left:
+        if (direction == direction_e::up) direction = direction_e::left;
+        else if (direction == direction_e::right) direction = direction_e::down;
+        break;
+      case track_type_e::up_right:
+        if (direction == direction_e::down) direction = direction_e::right;
+        else if (direction == direction_e::left) direction = direction_e::up;
+        break;
+      case track_type_e::up_left:
+        if (direction == direction_e::down) direction = direction_e::left;
+        else if (direction == direction_e::right) direction = direction_e::up;
+        break;
+      default:
+        break;
+    }
+    return {static_cast<uint8_t>(direction), static_cast<uint8_t>(behavior)};
+  }
+
+  const int num_track_types = track_type_e::intersection + 1;
+
+  constexpr int transition_index(int track, int direction, int behavior) {
+    return (track * 4 + direction) * cart_behavior_e::sentinel + behavior;
+  }
+
+  // Every (track type, direction, behavior) combination, built at compile time
+  constexpr std::array<transition_t, num_track_types * 4 * cart_behavior_e::sentinel> make_transition_table() {
+    std::array<transition_t, num_track_types * 4 * cart_behavior_e::sentinel> table{};
+    for (int track = 0; track < num_track_types; track++) {
+      for (int direction = 0; direction < 4; direction++) {
+        for (int behavior = 0; behavior < cart_behavior_e::sentinel; behavior++) {
+          table[transition_index(track, direction, behavior)] =
+            compute_transition(static_cast<track_type_e>(track), direction, behavior);
+        }
+      }
+    }
+    return table;
+  }
+
+  constexpr auto transition_table = make_transition_table();
+
+  static_assert(transition_table[transition_index(track_type_e::intersection, direction_e::up,
+                                                  cart_behavior_e::turn_left)].direction == direction_e::left);
+  static_assert(transition_table[transition_index(track_type_e::intersection, direction_e::left,
+                                                  cart_behavior_e::turn_right)].behavior == cart_behavior_e::turn_left);
+  static_assert(transition_table[transition_index(track_type_e::down_left, direction_e::right,
+                                                  cart_behavior_e::go_straight)].direction == direction_e::down);
+
+  template<int env_dim>
+  struct environment_t {
+    std::array<std::array<track_t, env_dim>, env_dim> tracks;
+    std::vector<cart_t> carts;
+
+    std::pair<int, int> get_first_collision() {
+      std::sort(carts.begin(), carts.end());
+
+      for (int i = 1; i < carts.size(); i++) {
+        auto &cart0 = carts[i - 1];
+        auto &cart1 = carts[i];
+        if ((cart0.get_x() == cart1.get_x()) && (cart0.get_y() == cart1.get_y())) {
+          return {cart0.get_x(), cart0.get_y()};
+        }
+      }
+
+      return {-1, -1};
+    }
+
+    bool has_cart_collision() {
+      auto[x, y] = get_first_collision();
+      return x != -1 && y != -1;
+    }
+
+    void remove_colliding_carts() {
+      std::sort(carts.begin(), carts.end());
+
+      std::vector<cart_t> next_carts;
+      int i = 0;
+      while (i < (carts.size() - 1)) {
+        auto &cart0 = carts[i];
+        auto &cart1 = carts[i + 1];
+        if ((cart0.get_x() == cart1.get_x()) && (cart0.get_y() == cart1.get_y())) {
+          // Don't copy the current cart and the next cart
+          i++;
+        } else {
+          next_carts.push_back(carts[i]);
+        }
+        i++;
+      }
+      if (i < carts.size()) {
+        next_carts.push_back(carts[i]);
+      }
+
+      carts = next_carts;
+    }
+
+    void tick() {
+      ticks_run.add();
+      std::sort(carts.begin(), carts.end());
+
+      for (auto &cart : carts) {
+        int x = cart.get_x();
+        int y = cart.get_y();
+        int direction = cart.get_direction();
+        int next_x = x, next_y = y;
+        switch (direction) {
+          case direction_e::up: {
+            next_y = y - 1;
+            assert(y >= 0 && y < env_dim);
+            break;
+          }
+          case direction_e::down: {
+            next_y = y + 1;
+            assert(y >= 0 && y < env_dim);
+            break;
+          }
+          case direction_e::left: {
+            next_x = x - 1;
+            assert(x >= 0 && x < env_dim);
+            break;
+          }
+          case direction_e::right: {
+            next_x = x + 1;
+            assert(x >= 0 && x < env_dim);
+            break;
+          }
+        }
+        // Next track cell needs to have a track
+        assert(tracks[y][x].type != track_type_e::none);
+        // What's the next direction?
+        auto &next_track = tracks[next_y][next_x];
+        auto &transition = transition_table[transition_index(next_track.type, direction, cart.get_behavior())];
+        int next_direction = transition.direction;
+        bool turned_at_intersection = next_track.type == track_type_e::intersection;
+
+        cart.move_to(next_x, next_y, next_direction, turned_at_intersection);
+      }
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, environment_t &env) {
+      std::array<std::array<char, env_dim>, env_dim> output;
+      for (int y = 0; y < env_dim; y++) {
+        for (int x = 0; x < env_dim; x++) {
+          char out_c = ' ';
+          switch (env.tracks[y][x].type) {
+            case track_type_e::intersection:
+              out_c = '+';
+              break;
+            case track_type_e::up_down:
+              out_c = '|';
+              break;
+            case track_type_e::left_right:
+              out_c = '-';
+              break;
+            case track_type_e::up_left:
+              out_c = '%';
+              break;
+            case track_type_e::down_left:
+              out_c = '\\';
+              break;
+            case track_type_e::down_right:
+              out_c = '/';
+              break;
+            case track_type_e::up_right:
+              out_c = '#';
+              break;
+            case track_type_e::none:
+              out_c = ' ';
+              break;
+          }
+          output[y][x] = out_c;
+        }
+      }
+      if (trace_carts_collisions) {
+        // Add Carts and collisions
+        for (auto &cart : env.carts) {
+          char out_c = 0;
+          char in = output[cart.get_y()][cart.get_x()];
+          if (in == '^' || in == '>' || in == 'v' || in == '<' || in == 'X') {
+            out_c = 'X';
+          } else {
+            switch (cart.get_direction()) {
+              case direction_e::up:
+                out_c = '^';
+                break;
+              case direction_e::right:
+                out_c = '>';
+                break;
+              case direction_e::down:
+                out_c = 'v';
+                break;
+              case direction_e::left:
+                out_c = '<';
+                break;
+            }
+          }
+          output[cart.get_y()][cart.get_x()] = out_c;
+        }
+      }
+
+      for (int y = 0; y < env_dim; y++) {
+        for (int x = 0; x < env_dim; x++) {
+          out << output[y][x];
+        }
+        out << std::endl;
+      }
+      out << std::endl;
+
+      return out;
+    }
+  };
+
+  template<int env_dim>
+  void read_day13_data(environment_t<env_dim> &outdata, const char *filepath) {
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::string_view line;
+    std::array<std::array<char, env_dim>, env_dim> processed_input{0};
+    int x = 0, y = 0;
+    // Process the input first
+    while (input::next_line(text, line)) {
+      if (trace_read) std::cout << "Read: " << line << std::endl;
+      int x = 0;
+      for (auto c : line) {
+        processed_input[y][x] = c;
+        x++;
+      }
+      y++;
+    }
+    if (trace_read) std::cout << "Processed input.." << std::endl;
+
+    // Load processed input into environment
+    for (int y = 0; y < env_dim; y++) {
+      for (int x = 0; x < env_dim; x++) {
+        // Tracks
+        auto pc = processed_input[y][x];
+        switch (pc) {
+          case '+':
+            outdata.tracks[y][x].type = track_type_e::intersection;
+            break;
+          case '|':
+            outdata.tracks[y][x].type = track_type_e::up_down;
+            break;
+          case '-':
+            outdata.tracks[y][x].type = track_type_e::left_right;
+            break;
+          case '/': {
+            outdata.tracks[y][x].type = track_type_e::down_right;
+            int left_x = x - 1;
+            if ((left_x >= 0) && (left_x < env_dim)) {
+              auto p = processed_input[y][left_x];
+              if (p == '-' || p == '+' || p == '>' || p == '<') {
+                outdata.tracks[y][x].type = track_type_e::up_left;
+              }
+            }
+            break;
+          }
+          case '\\': {
+            outdata.tracks[y][x].type = track_type_e::up_right;
+            int left_x = x - 1;
+            if ((left_x >= 0) && (left_x < env_dim)) {
+              auto p = processed_input[y][left_x];
+              if (p == '-' || p == '+' || p == '>' || p == '<') {
+                outdata.tracks[y][x].type = track_type_e::down_left;
+              }
+            }
+            break;
+          }
+          case '^':
+          case '>':
+          case 'v':
+          case '<': {
+            // Cart is in cell. Figure out the track underneath the cart
+            int left_x = x - 1;
+            int right_x = x + 1;
+            int up_y = y - 1;
+            int down_y = y + 1;
+            bool left = false, right = false, up = false, down = false;
+            if ((left_x >= 0) && (left_x < env_dim)) {
+              auto p = processed_input[y][left_x];
+              left = p == '-' || p == '\\' || p == '/' || p == '+';
+            }
+            if ((right_x >= 0) && (right_x < env_dim)) {
+              auto p = processed_input[y][right_x];
+              right = p == '-' || p == '\\' || p == '/' || p == '+';
+            }
+            if ((up_y >= 0) && (up_y < env_dim)) {
+              auto p = processed_input[up_y][x];
+              up = p == '|' || p == '\\' || p == '/' || p == '+';
+            }
+            if ((down_y >= 0) && (down_y < env_dim)) {
+              auto p = processed_input[down_y][x];
+              down = p == '|' || p == '\\' || p == '/' || p == '+';
+            }
+            // Check patterns
+            if (up && down && left && right) outdata.tracks[y][x].type = track_type_e::intersection;
+            else if (down && left) outdata.tracks[y][x].type = track_type_e::down_left;
+            else if (up && left) outdata.tracks[y][x].type = track_type_e::up_left;
+            else if (up && right) outdata.tracks[y][x].type = track_type_e::up_right;
+            else if (down && right) outdata.tracks[y][x].type = track_type_e::down_right;
+            else if (left && right) outdata.tracks[y][x].type = track_type_e::left_right;
+            else if (up && down) outdata.tracks[y][x].type = track_type_e::up_down;
+
+            break;
+          }
+          case ' ': {
+            // Empty
+            break;
+          }
+          case 0: {
+            // End of row
+            break;
+          }
+          default: {
+            std::cerr << "Unknown input char '" << pc << "' (" << (int) pc << ")" << " (" << x << ", " << y << ")"
+                      << std::endl;
+            throw std::invalid_argument("Unknown input character!");
+          }
+        }
+
+        // Carts
+        if (pc == '^' || pc == '>' || pc == 'v' || pc == '<') {
+          int direction;
+          switch (pc) {
+            case '^': {
+              direction = direction_e::up;
+              break;
+            }
+            case '>': {
+              direction = direction_e::right;
+              break;
+            }
+            case 'v': {
+              direction = direction_e::down;
+              break;
+            }
+            case '<': {
+              direction = direction_e::left;
+              break;
+            }
+          }
+          cart_t cart;
+          cart.initialize(x, y, direction);
+          outdata.carts.push_back(cart);
+        }
+      }
+    }
+  }
+
+  struct moving_cart_t {
+    int x, y;
+    int direction;
+    int behavior;
+    bool crashed;
+
+    bool operator<(const moving_cart_t &other) const {
+      return y < other.y || (y == other.y && x < other.x);
+    }
+  };
+
+  // Cart simulation that detects collisions the moment a cart moves: a bitmap with one bit per track cell marks the
+  // occupied cells, so a move onto a set bit is a crash, and cart_at names the cart it crashes into. Tracks are a byte
+  // grid and turns come from transition_table. Crashed carts are removed on the spot (the other cart may not have moved
+  // yet this tick) and every crash is recorded in order. Carts stay in reading order between ticks with an insertion
+  // sort, which is close to linear as carts only move one cell per tick.
+  struct cart_engine_t {
+    grid2d::grid2d_t<track_type_e> tracks;
+    std::vector<uint64_t> occupied;
+    std::vector<int> cart_at;  // Index into carts of the cart on each cell, valid where the occupied bit is set
+    std::vector<moving_cart_t> carts;
+    std::vector<std::pair<int, int>> collisions;
+    long ticks = 0;
+
+    template<int env_dim>
+    void initialize(const environment_t<env_dim> &env) {
+      tracks.resize(env_dim, env_dim);
+      tracks.for_each([&env](int x, int y, track_type_e &track) {
+        track = env.tracks[y][x].type;
+      });
+      occupied.assign((tracks.cells.size() + 63) / 64, 0);
+      carts.clear();
+      for (auto &cart : env.carts) {
+        carts.push_back({cart.get_x(), cart.get_y(), cart.get_direction(), cart.get_behavior(), false});
+        set_occupied(tracks.index_of(cart.get_x(), cart.get_y()), true);
+      }
+      std::sort(carts.begin(), carts.end());
+      cart_at.assign(tracks.cells.size(), -1);
+      index_carts();
+      collisions.clear();
+      ticks = 0;
+    }
+
+    bool is_occupied(int index) const {
+      return (occupied[index / 64] >> (index % 64)) & 1;
+    }
+
+    void set_occupied(int index, bool value) {
+      if (value) occupied[index / 64] |= uint64_t(1) << (index % 64);
+      else occupied[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    void index_carts() {
+      for (size_t i = 0; i < carts.size(); i++) {
+        cart_at[tracks.index_of(carts[i].x, carts[i].y)] = static_cast<int>(i);
+      }
+    }
+
+    void tick() {
+      ticks_run.add();
+      for (size_t i = 0; i < carts.size(); i++) {
+        auto &cart = carts[i];
+        if (cart.crashed) continue;
+
+        int next_x = cart.x, next_y = cart.y;
+        switch (cart.direction) {
+          case direction_e::up:     next_y--;   break;
+          case direction_e::down:   next_y++;   break;
+          case direction_e::left:   next_x--;   break;
+          case direction_e::right:  next_x++;   break;
+        }
+        assert(tracks.contains(next_x, next_y) && tracks.at(next_x, next_y) != track_type_e::none);
+
+        int index = tracks.index_of(cart.x, cart.y);
+        int next_index = tracks.index_of(next_x, next_y);
+        set_occupied(index, false);
+        if (is_occupied(next_index)) {
+          // Crash: take both carts off the track
+          set_occupied(next_index, false);
+          carts[cart_at[next_index]].crashed = true;
+          cart.crashed = true;
+          collisions.emplace_back(next_x, next_y);
+          collisions_detected.add();
+          continue;
+        }
+        set_occupied(next_index, true);
+        cart_at[next_index] = static_cast<int>(i);
+
+        auto &transition = transition_table[transition_index(tracks.cells[next_index], cart.direction, cart.behavior)];
+        cart.direction = transition.direction;
+        cart.behavior = transition.behavior;
+        cart.x = next_x;
+        cart.y = next_y;
+      }
+
+      carts.erase(std::remove_if(carts.begin(), carts.end(), [](const moving_cart_t &cart) { return cart.crashed; }),
+                  carts.end());
+      // Back to reading order
+      for (size_t i = 1; i < carts.size(); i++) {
+        for (size_t j = i; j > 0 && carts[j] < carts[j - 1]; j--) {
+          std::swap(carts[j], carts[j - 1]);
+        }
+      }
+      index_carts();
+      ticks++;
+    }
+
+    std::pair<int, int> find_first_collision() {
+      instrument::scoped_timer_t timer(collision_search_timer);
+      while (collisions.empty() && !carts.empty()) {
+        tick();
+      }
+      return collisions.empty() ? std::pair<int, int>{-1, -1} : collisions.front();
+    }
+
+    // Location of the last cart at the end of the tick that leaves it alone on the tracks, or {-1, -1} if the last
+    // carts crash into each other
+    std::pair<int, int> find_last_cart() {
+      while (carts.size() > 1) {
+        tick();
+      }
+      if (carts.empty()) return {-1, -1};
+      return {carts[0].x, carts[0].y};
+    }
+  };
+
+  // Ticks until the first collision and returns its location
+  template<int env_dim>
+  std::pair<int, int> find_first_collision(environment_t<env_dim> &env) {
+    instrument::scoped_timer_t timer(collision_search_timer);
+    while (!env.has_cart_collision()) {
+      env.tick();
+    }
+    collisions_detected.add();
+    return env.get_first_collision();
+  }
+
+  // Ticks and removes colliding carts until a single cart is left. Returns its location
+  template<int env_dim>
+  std::pair<int, int> find_last_cart(environment_t<env_dim> &env) {
+    while (env.carts.size() > 1) {
+      find_first_collision(env);
+      env.remove_colliding_carts();
+    }
+    assert(env.carts.size() == 1);
+    return {env.carts[0].get_x(), env.carts[0].get_y()};
+  }
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY13_H
@@ -0,0 +1,512 @@
+#ifndef ADVENT_OF_CODE_2018_DAY15_H
+#define ADVENT_OF_CODE_2018_DAY15_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <regex>
+#include <limits>
+#include <array>
+#include <sstream>
+#include <cstdint>
+#include "grid2d.h"
+#include "instrument.h"
+
+namespace day15 {
+
+  const bool trace_read = false;
+  const bool trace_elves = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+  const bool enable_assertions = true;
+
+  inline instrument::counter_t rounds_run{"day15.rounds"};
+  inline instrument::counter_t pathfinding_calls{"day15.pathfinding_calls"};
+  inline instrument::timer_stats_t battle_timer{"day15.battle"};
+
+  enum unit_type_e {
+    goblin = 0,
+    elf,
+  };
+
+  struct unit_t {
+    unit_type_e type;
+    int x;
+    int y;
+    int attack_power = 3;
+    int hit_points = 200;
+    bool dead = false;  // Dead units stay in map_t::units so indices remain valid
+
+    bool is_enemy_of(const unit_t &other) const {
+      return type != other.type;
+    }
+
+    char get_type_char() const {
+      if (type == unit_type_e::goblin) {
+        return 'G';
+      } else {
+        return 'E';
+      }
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, unit_t &unit) {
+      if (unit.type == unit_type_e::goblin) {
+        out << "G(" << unit.x << "," << unit.y << ")(" << unit.hit_points << ")";
+      } else {
+        out << "E(" << unit.x << "," << unit.y << ")(" << unit.hit_points << ")";
+      }
+      return out;
+    }
+  };
+
+  enum cell_type_e : uint8_t {
+    none = 0,
+    wall,
+    unit,
+  };
+
+  // Index into map_t::units
+  typedef uint16_t unit_index_t;
+  const unit_index_t no_unit = 0xffff;
+
+  struct cell_t {
+    int x = -1;
+    int y = -1;
+    cell_type_e type = cell_type_e::none;
+    unit_index_t unit = no_unit;
+
+    bool is_empty() const {
+      return type == cell_type_e::none;
+    }
+
+    bool has_unit() const {
+      return unit != no_unit;
+    }
+
+    void set_unit(unit_index_t _unit) {
+      assert(type == cell_type_e::none);
+      unit = _unit;
+      type = cell_type_e::unit;
+    }
+
+    void clear() {
+      type = cell_type_e::none;
+      unit = no_unit;
+    }
+
+    // // Compartor based on (x, y)
+    // bool operator == (const cell_t &other) const {
+    //     return (x == other.x) && (y == other.y);
+    // }
+
+    // Comparator based on (x, y) reading order
+    bool operator<(const cell_t &other) const {
+      if (y < other.y) return true;
+      else if (y == other.y) {
+        return x < other.x;
+      }
+      return false;
+    }
+  };
+
+  enum battle_event_type_e : uint8_t {
+    unit_moved = 0,   // unit steps to the cell at index value of map_t::cells.cells
+    unit_attacked,    // unit deals value damage to target
+    round_ended,
+  };
+
+  // One change to the battle state, enough to replay it without any pathfinding
+  struct battle_event_t {
+    battle_event_type_e type;
+    unit_index_t unit = no_unit;
+    unit_index_t target = no_unit;
+    int value = 0;
+  };
+
+  // Events of a battle in order. Round first_round + r (counted like map_t::current_tick) starts at event
+  // round_starts[r]. The last round is partial if the battle ended during it.
+  struct battle_log_t {
+    int first_round = 0;
+    std::vector<size_t> round_starts;
+    std::vector<battle_event_t> events;
+  };
+
+  // Battle state without pathfinding scratch. Copies are independent of the map they came from. Units carry the attack
+  // powers they had when the snapshot was taken, so set_elf_attack_power after restoring to fight with another one.
+  struct battle_snapshot_t {
+    grid2d::grid2d_t<cell_t> cells;
+    std::vector<unit_t> units;
+    int num_alive[2] = {0, 0};
+    int current_tick = 0;
+  };
+
+  // Cells and units are plain values: cells refer to units by index into a dense array in which dead units are only
+  // flagged, so the whole battle state copies without any pointer fix-ups.
+  struct map_t {
+    grid2d::grid2d_t<cell_t> cells;
+    std::vector<unit_t> units;
+    int num_alive[2] = {0, 0};  // By unit_type_e
+    int map_width, map_height;
+    int current_tick = 0;
+    int elf_ap, goblin_ap;
+    // Breadth-first search scratch, indexed like cells.cells
+    std::vector<int> bfs_distance;
+    std::vector<int> bfs_queue;
+    std::vector<bool> is_attack_cell;
+    battle_log_t *event_log = nullptr;
+
+    map_t(int elf_attack_power = 3, int goblin_attack_power = 3) : elf_ap(elf_attack_power),
+                                                                   goblin_ap(goblin_attack_power) {}
+
+    char get_cell_char(const cell_t &cell) const {
+      switch (cell.type) {
+        case cell_type_e::wall:
+          return '#';
+        case cell_type_e::unit:
+          return units[cell.unit].get_type_char();
+        default:
+          return '.';
+      }
+    }
+
+    bool game_over() const {
+      return num_alive[unit_type_e::goblin] == 0 || num_alive[unit_type_e::elf] == 0;
+    }
+
+    int elapsed_rounds() const { return current_tick; }
+
+    battle_snapshot_t snapshot() const {
+      battle_snapshot_t snap;
+      snap.cells = cells;
+      snap.units = units;
+      std::copy(num_alive, num_alive + 2, snap.num_alive);
+      snap.current_tick = current_tick;
+      return snap;
+    }
+
+    // Unit attack powers come back with the units; elf_ap and goblin_ap are left as they are
+    void restore(const battle_snapshot_t &snap) {
+      cells = snap.cells;
+      units = snap.units;
+      std::copy(snap.num_alive, snap.num_alive + 2, num_alive);
+      current_tick = snap.current_tick;
+      map_width = cells.width;
+      map_height = cells.height;
+    }
+
+    void set_elf_attack_power(int attack_power) {
+      elf_ap = attack_power;
+      for (auto &unit : units) {
+        if (unit.type == unit_type_e::elf) unit.attack_power = attack_power;
+      }
+    }
+
+    // Records the events of every following round into battle_log, replacing its contents. nullptr stops recording.
+    void record_to(battle_log_t *battle_log) {
+      event_log = battle_log;
+      if (event_log) {
+        battle_log_t log;
+        log.first_round = current_tick;
+        *event_log = log;
+      }
+    }
+
+    // Changes the state as described by event
+    void apply(const battle_event_t &event) {
+      auto &unit = units[event.unit];
+      switch (event.type) {
+        case battle_event_type_e::unit_moved: {
+          cells.at(unit.x, unit.y).clear();
+          auto &step = cells.cells[event.value];
+          unit.x = step.x;
+          unit.y = step.y;
+          step.set_unit(event.unit);
+          break;
+        }
+        case battle_event_type_e::unit_attacked: {
+          auto &enemy = units[event.target];
+          enemy.hit_points -= event.value;
+          // Is enemy dead?
+          if (enemy.hit_points == 0) {
+            // - Mark cell as empty
+            cells.at(enemy.x, enemy.y).clear();
+            // - Leave a tombstone in the unit list
+            enemy.dead = true;
+            num_alive[enemy.type]--;
+          }
+          break;
+        }
+        case battle_event_type_e::round_ended:
+          current_tick++;
+          break;
+      }
+    }
+
+    void perform(const battle_event_t &event) {
+      if (event_log) event_log->events.push_back(event);
+      apply(event);
+    }
+
+    // Replays the logged rounds from the current one up to (but not including) round to_round, or to the end of the
+    // log. The state must be the one the log recorded at the start of the current round, e.g. a snapshot restored
+    // from when recording began.
+    void replay(const battle_log_t &battle_log, int to_round) {
+      int r = current_tick - battle_log.first_round;
+      if (game_over() || r < 0 || r >= (int) battle_log.round_starts.size()) return;
+      for (size_t e = battle_log.round_starts[r]; e < battle_log.events.size() && current_tick < to_round; e++) {
+        apply(battle_log.events[e]);
+      }
+    }
+
+    int total_remaining_hit_points() const {
+      int total_hp = 0;
+      for (auto &unit : units) {
+        if (!unit.dead) total_hp += unit.hit_points;
+      }
+      return total_hp;
+    }
+
+    void get_enemy_cells_in_range(std::vector<cell_t *> &out, const unit_t &unit) {
+      out.clear();
+      int x = unit.x;
+      int y = unit.y;
+      // In read order
+      constexpr std::pair<int, int> valid_deltas[4] = {
+        {0,  -1},
+        {-1, 0},
+        {1,  0},
+        {0,  1}
+      };
+      for (auto[dx, dy] : valid_deltas) {
+        auto cell = &cells.at(x + dx, y + dy);
+        if (cell->has_unit() && units[cell->unit].is_enemy_of(unit)) {
+          out.push_back(cell);
+        }
+      }
+
+      // Sort is unnecessary. Traversal above is in read order
+      // std::sort(out.begin(), out.end(), [](cell_t *a, cell_t *b) { return *a < *b; });
+    }
+
+    bool attack_enemies_in_range(unit_index_t unit_index) {
+      auto &unit = units[unit_index];
+      std::vector<cell_t *> adj_enemy_cells;
+      get_enemy_cells_in_range(adj_enemy_cells, unit);
+      if (!adj_enemy_cells.empty()) {
+        // Find enemy with lowest hit points
+        unit_index_t enemy_with_lowest_hp = no_unit;
+        int lowest_hp = std::numeric_limits<int>::max();
+        for (auto &adj_enemy_cell : adj_enemy_cells) {
+          if (units[adj_enemy_cell->unit].hit_points < lowest_hp) {
+            enemy_with_lowest_hp = adj_enemy_cell->unit;
+            lowest_hp = units[enemy_with_lowest_hp].hit_points;
+          }
+        }
+        // Deal damage equal to attack power, down to 0 hit points
+        auto &enemy = units[enemy_with_lowest_hp];
+        if (trace1)
+          std::cout << "\t\tAttacking " << enemy.get_type_char() << "(" << enemy.x << "," << enemy.y << ")"
+                    << std::endl;
+        perform({battle_event_type_e::unit_attacked, unit_index, enemy_with_lowest_hp,
+                 std::min(unit.attack_power, enemy.hit_points)});
+        return true;
+      }
+      return false;
+    }
+
+    // Breadth-first search over empty cells from start, filling bfs_distance (-1 where unreached). Cells are visited
+    // in order of distance and, within a distance, in the order they were found; neighbours are expanded in reading
+    // order. Stops after the first distance at which stop_at(index) holds for a cell, and returns the first such cell
+    // in reading order (the lowest index), or -1.
+    template<typename predicate_t>
+    int breadth_first_search(int start, predicate_t stop_at) {
+      pathfinding_calls.add();
+      const int neighbour_offsets[4] = {-cells.stride, -1, 1, cells.stride};
+      bfs_distance.assign(cells.cells.size(), -1);
+      bfs_queue.clear();
+      bfs_distance[start] = 0;
+      bfs_queue.push_back(start);
+      int found = -1;
+      for (size_t head = 0; head < bfs_queue.size(); head++) {
+        int index = bfs_queue[head];
+        if (found != -1 && bfs_distance[index] > bfs_distance[found]) break;
+        if (stop_at(index) && (found == -1 || index < found)) found = index;
+        if (found != -1) continue;
+        for (int offset : neighbour_offsets) {
+          int next = index + offset;
+          if (bfs_distance[next] == -1 && cells.cells[next].is_empty()) {
+            bfs_distance[next] = bfs_distance[index] + 1;
+            bfs_queue.push_back(next);
+          }
+        }
+      }
+      return found;
+    }
+
+    // The cell the unit steps to: the nearest empty cell next to an enemy is chosen first (ties in reading order),
+    // then the first neighbour of the unit in reading order that lies on a shortest path to it. Two searches: one out
+    // from the unit to pick the target, one back from the target to pick the step. Returns nullptr if no enemy is
+    // reachable.
+    cell_t *find_step_towards_closest_enemy(const unit_t &unit) {
+      is_attack_cell.assign(cells.cells.size(), false);
+      for (auto &enemy : units) {
+        if (enemy.dead || !enemy.is_enemy_of(unit)) continue;
+        int enemy_index = cells.index_of(enemy.x, enemy.y);
+        for (int offset : {-cells.stride, -1, 1, cells.stride}) {
+          if (cells.cells[enemy_index + offset].is_empty()) is_attack_cell[enemy_index + offset] = true;
+        }
+      }
+
+      int unit_index = cells.index_of(unit.x, unit.y);
+      int target = breadth_first_search(unit_index, [this](int index) { return is_attack_cell[index]; });
+      if (target == -1) return nullptr;
+
+      // Distances back from the target; the unit's own cell is not empty, so stop at its neighbours
+      breadth_first_search(target, [](int) { return false; });
+      cell_t *step = nullptr;
+      int step_distance = std::numeric_limits<int>::max();
+      for (int offset : {-cells.stride, -1, 1, cells.stride}) {
+        int distance = bfs_distance[unit_index + offset];
+        if (distance != -1 && distance < step_distance) {
+          step_distance = distance;
+          step = &cells.cells[unit_index + offset];
+        }
+      }
+      return step;
+    }
+
+    void move_toward_closest_enemy(unit_index_t unit_index) {
+      cell_t *step = find_step_towards_closest_enemy(units[unit_index]);
+      if (!step) return;
+
+      if (trace1) std::cout << "\t\tMoving to (" << step->x << "," << step->y << ")" << std::endl;
+      perform({battle_event_type_e::unit_moved, unit_index, no_unit, (int) (step - cells.cells.data())});
+    }
+
+    void tick_unit(unit_index_t unit_index) {
+      if (!attack_enemies_in_range(unit_index)) {
+        move_toward_closest_enemy(unit_index);
+        attack_enemies_in_range(unit_index);
+      }
+    }
+
+    void tick() {
+      rounds_run.add();
+
+      if (trace1) std::cout << "Starting round" << std::endl;
+      if (event_log) event_log->round_starts.push_back(event_log->events.size());
+      // Living units in reading order. Units killed during the round are skipped by their tombstone.
+      std::vector<unit_index_t> order;
+      for (unit_index_t i = 0; i < units.size(); i++) {
+        if (!units[i].dead) order.push_back(i);
+      }
+      std::sort(order.begin(), order.end(), [this](unit_index_t a, unit_index_t b) {
+        return units[a].y < units[b].y || (units[a].y == units[b].y && units[a].x < units[b].x);
+      });
+      for (auto unit_index : order) {
+        // No targets left! Early exit if game over (whithout incrementing ticks)
+        if (game_over()) {
+          return;
+        }
+
+        // Unit may be dead. Don't tick dead units
+        auto &unit = units[unit_index];
+        if (!unit.dead) {
+          if (trace1)
+            std::cout << "\tTicking " << unit.get_type_char() << "(" << unit.x << "," << unit.y << ")" << std::endl;
+          tick_unit(unit_index);
+        }
+      }
+
+      perform({battle_event_type_e::round_ended});
+    }
+
+    friend std::istream &operator>>(std::istream &in, map_t &env) {
+      std::vector<std::string> lines;
+      std::string line;
+      while (!in.eof()) {
+        getline(in, line);
+        if (!line.empty()) lines.push_back(line);
+      }
+      env.map_width = lines[0].size();
+      env.map_height = lines.size();
+      env.cells.resize(env.map_width, env.map_height);
+      for (int y = 0; y < env.map_height; y++) {
+        for (int x = 0; x < lines[y].size(); x++) {
+          auto &new_cell = env.cells.at(x, y);
+          new_cell.x = x;
+          new_cell.y = y;
+          switch (lines[y][x]) {
+            case '#': {
+              new_cell.type = cell_type_e::wall;
+              break;
+            }
+            case 'G':
+            case 'E': {
+              if (env.units.size() >= no_unit) throw new std::invalid_argument("Too many units!");
+              unit_t unit;
+              unit.type = lines[y][x] == 'G' ? unit_type_e::goblin : unit_type_e::elf;
+              unit.attack_power = unit.type == unit_type_e::goblin ? env.goblin_ap : env.elf_ap;
+              unit.x = x;
+              unit.y = y;
+              new_cell.set_unit(static_cast<unit_index_t>(env.units.size()));
+              env.units.push_back(unit);
+              env.num_alive[unit.type]++;
+              break;
+            }
+          }
+        }
+      }
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, map_t &env) {
+      out << "After " << env.current_tick << " rounds:" << std::endl;
+      std::vector<cell_t *> unit_cells;
+      for (int y = 0; y < env.cells.height; y++) {
+        auto *row = env.cells.row(y);
+        unit_cells.clear();
+        for (int x = 0; x < env.cells.width; x++) {
+          auto &cell = row[x];
+          if (cell.type == cell_type_e::unit) unit_cells.push_back(&cell);
+          out << env.get_cell_char(cell);
+        }
+        // Render hps
+        if (!unit_cells.empty()) out << "    ";
+        for (auto unit_cell : unit_cells) {
+          out << env.units[unit_cell->unit] << ", ";
+        }
+        out << std::endl;
+      }
+      out << std::endl;
+      return out;
+    }
+  };
+
+  void read_day15_data(map_t &outdata, const char *filepath);
+
+  // State of the battle in filepath before the first round
+  battle_snapshot_t read_day15_snapshot(const char *filepath);
+
+  // Runs the battle to completion and returns its outcome (full rounds * remaining hit points)
+  int run_battle(map_t &map);
+
+  // Raises the elves' attack power until a battle ends without elf deaths and returns that battle's outcome
+  int find_outcome_with_no_elf_deaths(const char *filepath);
+
+  // Same result as find_outcome_with_no_elf_deaths. num_threads workers (0 = one per hardware thread) share the probes
+  // that double the attack power until the elves win without deaths, the binary search below that win and the
+  // confirmation of every lower attack power in case outcomes are not monotone. Battles stop at the first elf death
+  // or once a lower attack power has won.
+  int find_outcome_with_no_elf_deaths_parallel(const char *filepath, unsigned num_threads = 0);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY15_H
@@ -0,0 +1,263 @@
+#ifndef ADVENT_OF_CODE_2018_DAY16_H
+#define ADVENT_OF_CODE_2018_DAY16_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <limits>
+#include <array>
+#include <sstream>
+#include "scanner.h"
+#include "device.h"
+
+namespace day16 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = true;
+  const bool enable_assertions = true;
+
+  // Opcodes are the device's, shared with days 19 and 21. opcode_mapper_t deduces the puzzle's numbering.
+  using device::opcode_e;
+
+  struct instruction_t {
+    int opcode;
+    int inputA;
+    int inputB;
+    int outputC;
+
+    friend std::istream &operator>>(std::istream &in, instruction_t &instr) {
+      in >> instr.opcode >> instr.inputA >> instr.inputB >> instr.outputC;
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const instruction_t &instr) {
+      out << instr.opcode << " " << instr.inputA << " " << instr.inputB << " " << instr.outputC;
+      return out;
+    }
+  };
+
+  struct program_t {
+    std::vector<instruction_t> instructions;
+
+    void remap_opcodes(const std::array<int, opcode_e::num_op_codes> &mapping) {
+      for (auto &instruction : instructions) {
+        instruction.opcode = mapping[instruction.opcode];
+      }
+    }
+
+    device::program_t to_device_program() const {
+      device::program_t program;
+      for (auto &instruction : instructions) {
+        program.instructions.push_back(
+          {instruction.opcode, instruction.inputA, instruction.inputB, instruction.outputC});
+      }
+      return program;
+    }
+
+    friend std::istream &operator>>(std::istream &in, program_t &program) {
+      instruction_t instruction;
+      while (!in.eof()) {
+        in >> instruction;
+        program.instructions.push_back(instruction);
+      }
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const program_t &program) {
+      for (auto &instruction : program.instructions) {
+        out << instruction << std::endl;
+      }
+      return out;
+    }
+  };
+
+  struct device_state_t {
+    std::array<int, 4> registers{0};
+
+    void clear() { registers = std::array<int, 4>{0}; }
+
+    bool operator==(const device_state_t &other) const {
+      return registers == other.registers;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const device_state_t &ds) {
+      out << "[" << ds.registers[0] << ", " << ds.registers[1] << ", " << ds.registers[2] << ", " << ds.registers[3]
+          << "]";
+      return out;
+    }
+  };
+
+  // Reads the "[a, b, c, d]" register list of a trace line. Consumes nothing if it fails.
+  inline bool scan_registers(scanner::scanner_t &scan, device_state_t &ds) {
+    return scan.attempt([&ds](scanner::scanner_t &s) {
+      return s.literal("[") && s.number(ds.registers[0]) && s.literal(", ") && s.number(ds.registers[1]) &&
+             s.literal(", ") && s.number(ds.registers[2]) && s.literal(", ") && s.number(ds.registers[3]) &&
+             s.literal("]");
+    });
+  }
+
+  struct device_t {
+    device_state_t state;
+
+    void clear() { state.clear(); }
+
+    // Runs the program on the shared device, which has registers to spare
+    void run(const program_t &program) {
+      device::device_t engine;
+      engine.run(program.to_device_program());
+      std::copy(engine.state.registers.begin(), engine.state.registers.begin() + state.registers.size(),
+                state.registers.begin());
+    }
+
+    void process(const instruction_t &instruction) {
+      device::instructions_executed.add();
+      device::execute(instruction.opcode, instruction.inputA, instruction.inputB, instruction.outputC, state.registers);
+    }
+  };
+
+  struct instruction_event_t {
+    device_state_t before;
+    instruction_t instruction;
+    device_state_t after;
+  };
+
+  struct instruction_trace_t {
+    instruction_t event_instruction;
+    std::vector<int> candidate_opcodes;
+  };
+
+  struct instruction_tracer_t {
+    device_t device;
+    std::vector<instruction_trace_t> traces;
+
+    void process_event(const instruction_event_t &e) {
+      // Opcode is unknown. Generate traces
+      instruction_trace_t trace;
+      trace.event_instruction = e.instruction;
+      if (trace1) std::cout << "Processing event instr " << e.instruction << std::endl;
+      for (int candidate_opcode = 0; candidate_opcode < opcode_e::num_op_codes; candidate_opcode++) {
+        device.clear();
+        device.state = e.before;
+        instruction_t candidate_test_instruction = e.instruction;
+        candidate_test_instruction.opcode = candidate_opcode;
+        device.process(candidate_test_instruction);
+        if (device.state == e.after) {
+          if (trace1) std::cout << "\tOpcode " << candidate_opcode << " produced expected output" << std::endl;
+          trace.candidate_opcodes.push_back(candidate_opcode);
+        }
+      }
+      traces.push_back(trace);
+    }
+
+    int get_samples_with_more_than_3_candidate_opcodes() {
+      int result = 0;
+      for (auto &t : traces) {
+        if (t.candidate_opcodes.size() >= 3) {
+          result++;
+        }
+      }
+      return result;
+    }
+
+    friend std::istream &operator>>(std::istream &in, instruction_tracer_t &tracer) {
+      while (!in.eof()) {
+        std::string line;
+        getline(in, line);
+        if (line.empty()) continue;
+
+        instruction_event_t e;
+        scanner::scanner_t before_scan(line);
+        if (!(before_scan.literal("Before: ") && scan_registers(before_scan, e.before))) {
+          throw new std::invalid_argument("Cannot parse before state!");
+        }
+
+        in >> e.instruction;
+        // Consume newline
+        getline(in, line);
+
+        getline(in, line);
+        scanner::scanner_t after_scan(line);
+        if (!(after_scan.literal("After:  ") && scan_registers(after_scan, e.after))) {
+          throw new std::invalid_argument("Cannot parse after state!");
+        }
+
+        if (trace_read) {
+          std::cout << "Before: " << e.before << std::endl;
+          std::cout << e.instruction << std::endl;
+          std::cout << "After: " << e.after << std::endl;
+        }
+
+        tracer.process_event(e);
+      }
+
+      return in;
+    }
+  };
+
+  struct opcode_mapper_t {
+    std::array<std::set<int>, opcode_e::num_op_codes> internal_to_trace_opcode_mapping;
+
+    std::array<int, opcode_e::num_op_codes> process_traces(const std::vector<instruction_trace_t> &input) {
+      std::fill(internal_to_trace_opcode_mapping.begin(), internal_to_trace_opcode_mapping.end(), std::set<int>());
+      for (auto &trace : input) {
+        auto trace_opcode = trace.event_instruction.opcode;
+        for (auto &candidate_opcode : trace.candidate_opcodes) {
+          internal_to_trace_opcode_mapping[candidate_opcode].insert(trace_opcode);
+        }
+      }
+      if (trace2) {
+        std::cout << "Instruction mapping (internal -> trace)" << std::endl;
+        for (int i = 0; i < internal_to_trace_opcode_mapping.size(); i++) {
+          std::cout << std::setw(2) << i << " -> ";
+          for (auto trace_opcode : internal_to_trace_opcode_mapping[i]) {
+            std::cout << std::setw(2) << trace_opcode << " ";
+          }
+          std::cout << std::endl;
+        }
+        std::cout << std::endl;
+      }
+
+      std::array<int, opcode_e::num_op_codes> trace_to_internal_mapping;
+      // Deduction loop
+      for (int i = 0; i < opcode_e::num_op_codes; i++) {
+        // Find internal opcode with a single trace opcode mapping
+        int mapped_internal_opcode = -1;
+        int trace_opcode = -1;
+        for (int internal_opcode = 0; internal_opcode < opcode_e::num_op_codes; internal_opcode++) {
+          auto &mapping = internal_to_trace_opcode_mapping[internal_opcode];
+          if (mapping.size() == 1) {
+            mapped_internal_opcode = internal_opcode;
+            trace_opcode = *mapping.begin();
+            break;
+          }
+        }
+        assert(trace_opcode != -1);
+        trace_to_internal_mapping[trace_opcode] = mapped_internal_opcode;
+        if (trace2) std::cout << "Mapping " << trace_opcode << " -> " << mapped_internal_opcode << std::endl;
+        // Remove trace opcode from mappings
+        for (auto &mapping : internal_to_trace_opcode_mapping) {
+          mapping.erase(trace_opcode);
+        }
+      }
+
+      return trace_to_internal_mapping;
+    }
+  };
+
+  void read_day16_trace_data(instruction_tracer_t &outdata, const char *filepath);
+
+  void read_day16_program_data(program_t &outdata, const char *filepath);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY16_H
@@ -0,0 +1,374 @@
+#ifndef ADVENT_OF_CODE_2018_DAY17_H
+#define ADVENT_OF_CODE_2018_DAY17_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <limits>
+#include <array>
+#include <sstream>
+#include <cstdint>
+#include "scanner.h"
+#include "grid2d.h"
+#include "instrument.h"
+
+namespace day17 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+  const bool enable_assertions = true;
+
+  inline instrument::counter_t simulation_passes{"day17.simulation_passes"};
+  inline instrument::counter_t tiles_visited{"day17.tiles_visited"};
+  inline instrument::timer_stats_t simulation_timer{"day17.simulate_until_stable"};
+  inline instrument::timer_stats_t flow_timer{"day17.flow_from_spring"};
+
+  enum tile_type_e : uint8_t {
+    sand,
+    wet_sand,
+    clay,
+    water,
+    spring,
+  };
+
+  inline char tile_char(tile_type_e type) {
+    switch (type) {
+      case tile_type_e::sand:
+        return '.';
+      case tile_type_e::clay:
+        return '#';
+      case tile_type_e::water:
+        return '~';
+      case tile_type_e::spring:
+        return '+';
+      case tile_type_e::wet_sand:
+        return '|';
+    }
+    return '?';
+  }
+
+  enum flow_dir_e {
+    down,
+    left,
+    right,
+  };
+
+  // One pending call of the depth-first flow in terrain_t::flow_from_spring
+  struct flow_frame_t {
+    int x, y;
+    flow_dir_e dir;
+    int stage;
+    bool left_blocked;
+  };
+
+  struct scan_t {
+    bool vertical;
+    int anchorPos;
+    int rangeMin;
+    int rangeMax;
+
+    friend void parse(std::string_view line, scan_t &scan) {
+      assert(!line.empty());
+
+      scanner::scanner_t line_scan(line);
+      char anchorDim, rangeDim;
+      if (!(line_scan.one_of("xy", anchorDim) && line_scan.literal("=") && line_scan.number(scan.anchorPos) &&
+            line_scan.literal(", ") && line_scan.one_of("xy", rangeDim) && line_scan.literal("=") &&
+            line_scan.number(scan.rangeMin) && line_scan.literal("..") && line_scan.number(scan.rangeMax))) {
+        throw new std::invalid_argument("Cannot parse before state!");
+      }
+      scan.vertical = (anchorDim == 'x');
+
+      if (trace_read) std::cout << "Read: " << scan << std::endl;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const scan_t &scan) {
+      out << (scan.vertical ? 'x' : 'y') << "=" << scan.anchorPos << ", " << (!scan.vertical ? 'x' : 'y') << "="
+          << scan.rangeMin << ".." << scan.rangeMax;
+      return out;
+    }
+  };
+
+  // One byte per tile over the scanned bounding box only: columns minScanX - 1 to maxScanX + 1 (water can spill one
+  // tile past the outermost clay) widened to include the spring, rows 0 to maxScanY + 1. A padding of 2 tiles lets
+  // the simulation look past the edges. Tiles are addressed in local coordinates, x - origin_x.
+  struct terrain_t {
+    grid2d::grid2d_t<tile_type_e> tiles;
+    std::vector<tile_type_e> write_row;  // Scratch copy of the row being simulated
+    int origin_x = 0;
+    int spring_x = 0;
+    int minScanX = std::numeric_limits<int>::max(), minScanY = std::numeric_limits<int>::max();
+    int maxScanX = std::numeric_limits<int>::min(), maxScanY = std::numeric_limits<int>::min();
+
+    void configure(const std::vector<scan_t> &scans) {
+      for (auto &scan : scans) {
+        int min_x = scan.vertical ? scan.anchorPos : scan.rangeMin;
+        int max_x = scan.vertical ? scan.anchorPos : scan.rangeMax;
+        int min_y = scan.vertical ? scan.rangeMin : scan.anchorPos;
+        int max_y = scan.vertical ? scan.rangeMax : scan.anchorPos;
+        minScanX = std::min(minScanX, min_x);
+        maxScanX = std::max(maxScanX, max_x);
+        minScanY = std::min(minScanY, min_y);
+        maxScanY = std::max(maxScanY, max_y);
+      }
+
+      origin_x = std::min(minScanX, 500) - 1;
+      int width = std::max(maxScanX, 500) + 1 - origin_x + 1;
+      tiles.resize(width, maxScanY + 2, 2, tile_type_e::sand);
+      spring_x = 500 - origin_x;
+      tiles.at(spring_x, 0) = tile_type_e::spring;
+
+      for (auto &scan : scans) {
+        if (scan.vertical) {
+          for (int y = scan.rangeMin; y <= scan.rangeMax; y++) {
+            tiles.at(scan.anchorPos - origin_x, y) = tile_type_e::clay;
+          }
+        } else {
+          auto *row = tiles.row(scan.anchorPos);
+          for (int x = scan.rangeMin; x <= scan.rangeMax; x++) {
+            row[x - origin_x] = tile_type_e::clay;
+          }
+        }
+      }
+    }
+
+    int get_water_reach() {
+      int result = 0;
+      for (int y = minScanY; y <= maxScanY; y++) {
+        auto *row = tiles.row(y);
+        for (int x = 0; x < tiles.width; x++) {
+          if (row[x] == tile_type_e::water || row[x] == tile_type_e::wet_sand) {
+            result++;
+          }
+        }
+      }
+      return result;
+    }
+
+    int get_standing_water() {
+      int result = 0;
+      for (int y = minScanY; y <= maxScanY; y++) {
+        auto *row = tiles.row(y);
+        for (int x = 0; x < tiles.width; x++) {
+          if (row[x] == tile_type_e::water) {
+            result++;
+          }
+        }
+      }
+      return result;
+    }
+
+    void simulate() {
+      simulation_passes.add();
+      tiles_visited.add(static_cast<unsigned long long>(maxScanY + 2) * tiles.width);
+      if (trace1) std::cout << "Simulating.." << std::endl;
+      // Start scanning up from maxScanY + 1
+      for (int y = maxScanY + 1; y >= 0; y--) {
+        const tile_type_e *row = tiles.row(y);
+        write_row.assign(row - tiles.padding, row + tiles.width + tiles.padding);
+        tile_type_e *write = write_row.data() + tiles.padding;
+        // Left to right, see if there are water tiles that can flow
+        for (int x = 0; x < tiles.width; x++) {
+          const auto &current_tile = row[x];
+          if (trace1) std::cout << "\tProcessing " << describe(x, y) << std::endl;
+          auto &tile_below = tiles.at(x, y + 1);
+          if (current_tile == tile_type_e::spring) {
+            // We have a spring. Generate water
+            assert(tile_below == tile_type_e::sand || tile_below == tile_type_e::wet_sand);
+            if (trace1) std::cout << "\t\tGenerated water at " << describe(x, y + 1) << std::endl;
+            if (tile_below == tile_type_e::sand) tile_below = tile_type_e::wet_sand;
+          } else if (current_tile == tile_type_e::water) {
+            if (trace1) std::cout << "\t\tSTANDING WATER" << std::endl;
+          } else if (current_tile == tile_type_e::wet_sand) {
+            if (trace1) std::cout << "\t\tWET SAND" << std::endl;
+            // Can flow down?
+            if (tile_below == tile_type_e::sand || tile_below == tile_type_e::wet_sand) {
+              if (trace1) std::cout << "\t\tMoving water DOWN to " << describe(x, y + 1) << std::endl;
+              tile_below = tile_type_e::wet_sand;
+              // Check if tiles below represent standing water
+              if (tile_below == tile_type_e::wet_sand) {
+                auto *row_below = tiles.row(y + 1);
+                int wx = x;
+                while (row_below[wx] == tile_type_e::wet_sand) {
+                  wx--;
+                }
+                bool clay_to_the_left = row_below[wx] == tile_type_e::clay;
+                int wx2 = x;
+                while (row_below[wx2] == tile_type_e::wet_sand) {
+                  wx2++;
+                }
+                bool clay_to_the_right = row_below[wx2] == tile_type_e::clay;
+                if (clay_to_the_left && clay_to_the_right) {
+                  // Check if tiles below on clay or water
+                  bool change_to_standing_water = true;
+                  for (int sx = wx + 1; sx < wx2; sx++) {
+                    auto &tile_below_below = tiles.at(sx, y + 2);
+                    if (tile_below_below != tile_type_e::clay && tile_below_below != tile_type_e::water) {
+                      change_to_standing_water = false;
+                      break;
+                    }
+                  }
+                  if (change_to_standing_water) {
+                    for (int sx = wx + 1; sx < wx2; sx++) {
+                      row_below[sx] = tile_type_e::water;
+                    }
+                  }
+                }
+              }
+            } else { // water or clay
+              bool go_left = false;
+              if (row[x - 1] == tile_type_e::sand || row[x - 1] == tile_type_e::wet_sand) {
+                go_left = true;
+              }
+              bool go_right = false;
+              if (row[x + 1] == tile_type_e::sand || row[x + 1] == tile_type_e::wet_sand) {
+                go_right = true;
+              }
+
+              assert(go_left || go_right);
+              if (go_left) {
+                if (trace1) std::cout << "\t\tMoving water LEFT" << std::endl;
+                write[x - 1] = tile_type_e::wet_sand;
+                // Stay wet sand
+              }
+              if (go_right) {
+                if (trace1) std::cout << "\t\tMoving water RIGHT" << std::endl;
+                write[x + 1] = tile_type_e::wet_sand;
+                // Stay wet sand
+              }
+            }
+          }
+        }
+        std::copy(write_row.begin(), write_row.end(), tiles.row(y) - tiles.padding);
+      }
+    }
+
+    // Pours water from the spring in a single depth-first pass that only visits tiles the water reaches. Water
+    // entering a tile falls first; if the tile below is blocked (clay or standing water) it spreads left and right,
+    // and a row blocked on both sides fills with standing water, which in turn blocks the row above. The recursion is
+    // kept on an explicit stack of frames, so tall scans cannot overflow the call stack.
+    void flow_from_spring() {
+      simulation_passes.add();
+      std::vector<flow_frame_t> stack;
+      stack.push_back({spring_x, 1, flow_dir_e::down, 0, false});
+      bool blocked = false;   // Result of the last finished frame
+
+      while (!stack.empty()) {
+        auto frame = stack.back();
+        auto &tile = tiles.at(frame.x, frame.y);
+        switch (frame.stage) {
+          case 0: {
+            if (frame.y > maxScanY) {
+              blocked = false;
+            } else if (tile == tile_type_e::clay || tile == tile_type_e::water) {
+              blocked = true;
+            } else if (tile == tile_type_e::wet_sand) {
+              blocked = false;
+            } else {
+              if (trace1) std::cout << "\tWetting " << describe(frame.x, frame.y) << std::endl;
+              tile = tile_type_e::wet_sand;
+              tiles_visited.add();
+              stack.back().stage = 1;
+              stack.push_back({frame.x, frame.y + 1, flow_dir_e::down, 0, false});
+              continue;
+            }
+            break;
+          }
+          case 1: {
+            // Back from below; spread only if the water cannot fall
+            if (!blocked) break;
+            if (frame.dir == flow_dir_e::down) {
+              stack.back().stage = 2;
+              stack.push_back({frame.x - 1, frame.y, flow_dir_e::left, 0, false});
+            } else {
+              stack.back().stage = 4;
+              int next_x = frame.dir == flow_dir_e::left ? frame.x - 1 : frame.x + 1;
+              stack.push_back({next_x, frame.y, frame.dir, 0, false});
+            }
+            continue;
+          }
+          case 2: {
+            stack.back().left_blocked = blocked;
+            stack.back().stage = 3;
+            stack.push_back({frame.x + 1, frame.y, flow_dir_e::right, 0, false});
+            continue;
+          }
+          case 3: {
+            blocked = frame.left_blocked && blocked;
+            if (blocked) {
+              // Clay on both sides: the row between the walls becomes standing water
+              auto *row = tiles.row(frame.y);
+              for (int x = frame.x; row[x] != tile_type_e::clay; x--) {
+                row[x] = tile_type_e::water;
+              }
+              for (int x = frame.x + 1; row[x] != tile_type_e::clay; x++) {
+                row[x] = tile_type_e::water;
+              }
+            }
+            break;
+          }
+          case 4:
+            // Sideways flow is blocked when its end is
+            break;
+        }
+        stack.pop_back();
+      }
+    }
+
+    // Tile type and scan coordinates, e.g. "|(500,3)"
+    std::string describe(int x, int y) const {
+      std::ostringstream out;
+      out << tile_char(tiles.at(x, y)) << "(" << x + origin_x << "," << y << ")";
+      return out.str();
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const terrain_t &terrain) {
+      for (int y = 0; y <= terrain.maxScanY; y++) {
+        auto *row = terrain.tiles.row(y);
+        for (int x = 0; x < terrain.tiles.width; x++) {
+          out << tile_char(row[x]);
+        }
+        out << std::endl;
+      }
+      out << std::endl;
+      return out;
+    }
+  };
+
+  void read_day17_data(std::vector<scan_t> &outdata, const char *filepath);
+
+  // Simulates until the water reach stops changing and returns it
+  inline int simulate_until_stable(terrain_t &terrain) {
+    instrument::scoped_timer_t timer(simulation_timer);
+    int old_water_reach = -1;
+    while (1) {
+      terrain.simulate();
+      if (terrain.get_water_reach() != 0 && terrain.get_water_reach() == old_water_reach) {
+        break;
+      }
+      if (trace2) std::cout << "Water Reach: " << terrain.get_water_reach() << std::endl;
+      old_water_reach = terrain.get_water_reach();
+    }
+    return terrain.get_water_reach();
+  }
+
+  // Fills the terrain with flow_from_spring and returns the water reach
+  inline int flow_until_stable(terrain_t &terrain) {
+    instrument::scoped_timer_t timer(flow_timer);
+    terrain.flow_from_spring();
+    return terrain.get_water_reach();
+  }
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY17_H
@@ -1,181 +1,96 @@
-#include <iostream>
-#include <iomanip>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
-#include <list>
-#include <regex>
-#include <limits>
-#include <array>
-#include <sstream>
+#include "day18.h"
+#include "input.h"
 
 namespace day18 {
 
-  const bool trace_read = false;
-  const bool trace1 = false;
-  const bool trace2 = false;
-  const bool enable_assertions = true;
-
-  enum acre_type_e {
-    ground,
-    trees,
-    lumberyard,
-  };
-
-  struct surrounding_area_t {
-    int num_trees = 0;
-    int num_lumberyards = 0;
-    int num_ground = 0;
-
-    surrounding_area_t(std::vector<std::vector<acre_type_e>> &acres, int x, int y) {
-      bool check_left = false, check_right = false;
-      // Row above
-      if (y > 0) {
-        auto &row_above = acres[y - 1];
-        if (x > 0) count_acre(row_above[x - 1]);
-        count_acre(row_above[x]);
-        if (x < row_above.size() - 1) count_acre(row_above[x + 1]);
-      }
-      // Same row
-      auto &row = acres[y];
-      if (x > 0) count_acre(row[x - 1]);
-      if (x < row.size() - 1) count_acre(row[x + 1]);
-      // Row below
-      if (y < acres.size() - 1) {
-        auto &row_below = acres[y + 1];
-        if (x > 0) count_acre(row_below[x - 1]);
-        count_acre(row_below[x]);
-        if (x < row_below.size() - 1) count_acre(row_below[x + 1]);
+  void read_day18_data(area_t &outdata, const char *filepath) {
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::vector<std::string_view> lines;
+    std::string_view line;
+    while (input::next_line(text, line)) {
+      lines.push_back(line);
+    }
+    outdata.acres.resize(lines.empty() ? 0 : lines[0].size(), lines.size(), 1, acre_type_e::ground);
+    const size_t width = static_cast<size_t>(outdata.acres.width);
+    for (size_t y = 0; y < lines.size(); y++) {
+      auto *row = outdata.acres.row(static_cast<int>(y));
+      for (size_t x = 0; x < lines[y].size() && x < width; x++) {
+        acre_type_e type = acre_type_e::ground;
+        switch (lines[y][x]) {
+          case '|':
+            type = acre_type_e::trees;
+            break;
+          case '#':
+            type = acre_type_e::lumberyard;
+            break;
+        }
+        row[x] = type;
       }
     }
+  }
 
-    friend std::ostream &operator<<(std::ostream &out, const surrounding_area_t &surround_area) {
-      out << ".(" << surround_area.num_ground << ") |(" << surround_area.num_trees << ") #("
-          << surround_area.num_lumberyards << ")";
-      return out;
-    }
+  // Neighbour counts are packed into one byte as trees + 16 * lumberyards (at most 8 of each)
+  inline uint8_t acre_weight(acre_type_e type) {
+    return static_cast<uint8_t>(type + (type >> 1) * 14);
+  }
 
-  private:
-    void count_acre(acre_type_e type) {
-      switch (type) {
-        case acre_type_e::ground:
-          num_ground++;
-          break;
-        case acre_type_e::lumberyard:
-          num_lumberyards++;
-          break;
-        case acre_type_e::trees:
-          num_trees++;
-          break;
+  // Next type of an acre by its type and packed neighbour counts:
+  // An open acre will become filled with trees if three or more adjacent acres contained trees. Otherwise, nothing happens.
+  // An acre filled with trees will become a lumberyard if three or more adjacent acres were lumberyards. Otherwise, nothing happens.
+  // An acre containing a lumberyard will remain a lumberyard if it was adjacent to at least one other lumberyard and at least one acre containing trees. Otherwise, it becomes open.
+  struct transition_table_t {
+    acre_type_e next[3][256];
+
+    transition_table_t() {
+      for (int counts = 0; counts < 256; counts++) {
+        int num_trees = counts & 0xf, num_lumberyards = counts >> 4;
+        next[acre_type_e::ground][counts] = num_trees >= 3 ? acre_type_e::trees : acre_type_e::ground;
+        next[acre_type_e::trees][counts] = num_lumberyards >= 3 ? acre_type_e::lumberyard : acre_type_e::trees;
+        next[acre_type_e::lumberyard][counts] =
+          num_lumberyards >= 1 && num_trees >= 1 ? acre_type_e::lumberyard : acre_type_e::ground;
       }
     }
   };
 
-  struct area_t {
-    std::vector<std::vector<acre_type_e>> acres;
+  const transition_table_t transitions;
 
-    void tick_one_minute() {
-      auto write_state = acres;
-      // An open acre will become filled with trees if three or more adjacent acres contained trees. Otherwise, nothing happens.
-      // An acre filled with trees will become a lumberyard if three or more adjacent acres were lumberyards. Otherwise, nothing happens.
-      // An acre containing a lumberyard will remain a lumberyard if it was adjacent to at least one other lumberyard and at least one acre containing trees. Otherwise, it becomes open.
-      for (int y = 0; y < acres.size(); y++) {
-        auto &read_row = acres[y];
-        auto &write_row = write_state[y];
-        for (int x = 0; x < read_row.size(); x++) {
-          surrounding_area_t surrounding_area(acres, x, y);
-          switch (read_row[x]) {
-            case acre_type_e::ground: {
-              if (surrounding_area.num_trees >= 3) {
-                if (trace1)
-                  std::cout << "\t" << surrounding_area << " Changing (" << x << "," << y << ") to trees " << std::endl;
-                write_row[x] = acre_type_e::trees;
-              }
-              break;
-            }
-            case acre_type_e::trees: {
-              if (surrounding_area.num_lumberyards >= 3) {
-                if (trace1)
-                  std::cout << "\t" << surrounding_area << " Changing (" << x << "," << y << ") to lumberyard "
-                            << std::endl;
-                write_row[x] = acre_type_e::lumberyard;
-              }
-              break;
-            }
-            case acre_type_e::lumberyard: {
-              if (surrounding_area.num_lumberyards >= 1 && surrounding_area.num_trees >= 1) {
-                // Stay a lumberyard
-              } else {
-                if (trace1)
-                  std::cout << "\t" << surrounding_area << " Changing (" << x << "," << y << ") to ground "
-                            << std::endl;
-                write_row[x] = acre_type_e::ground;
-              }
-              break;
-            }
-          }
-        }
-      }
-      acres = write_state;
-    }
+  void area_t::tick_rows(int y_begin, int y_end) {
+    // Weights of the 3 acres above, on and below the row for every column, padding included. Reused across minutes.
+    thread_local std::vector<uint8_t> column_weights;
+    column_weights.resize(acres.width + 2);
+    // Locals, as byte stores may alias the members
+    uint8_t *weights = column_weights.data() + 1;
+    const int width = acres.width;
 
-    int get_resource_value() {
-      int num_wooded_areas = 0, num_lumberyards = 0;
-      for (auto &row : acres) {
-        for (auto type : row) {
-          if (type == acre_type_e::trees) {
-            num_wooded_areas++;
-          } else if (type == acre_type_e::lumberyard) {
-            num_lumberyards++;
-          }
-        }
-      }
-      return num_wooded_areas * num_lumberyards;
-    }
+    for (int y = y_begin; y < y_end; y++) {
+      const acre_type_e *above = acres.row(y - 1);
+      const acre_type_e *read_row = acres.row(y);
+      const acre_type_e *below = acres.row(y + 1);
+      acre_type_e *write_row = write_state.row(y);
 
-    friend std::ostream &operator<<(std::ostream &out, const area_t &area) {
-      for (auto &row : area.acres) {
-        for (auto type : row) {
-          switch (type) {
-            case acre_type_e::ground:
-              out << ".";
-              break;
-            case acre_type_e::lumberyard:
-              out << "#";
-              break;
-            case acre_type_e::trees:
-              out << "|";
-              break;
-          }
+      for (int x = -1; x <= width; x++) {
+        weights[x] = acre_weight(above[x]) + acre_weight(read_row[x]) + acre_weight(below[x]);
+      }
+      // Sum of the 3 columns around x, minus the acre itself
+      for (int x = 0; x < width; x++) {
+        uint8_t counts = weights[x - 1] + weights[x] + weights[x + 1] - acre_weight(read_row[x]);
+        write_row[x] = transitions.next[read_row[x]][counts];
+        if (trace1 && write_row[x] != read_row[x]) {
+          std::cout << "\t" << surrounding_area_t(acres, x, y) << " Changing (" << x << "," << y << ") to "
+                    << static_cast<int>(write_row[x]) << std::endl;
         }
-        out << std::endl;
       }
-      out << std::endl;
-      return out;
+      acres_evaluated.add(width);
     }
-  };
+  }
 
-  void read_day18_data(area_t &outdata, const char *filepath) {
-    std::ifstream input_stream(filepath);
-    std::string line;
-    while (!input_stream.eof()) {
-      std::vector<acre_type_e> row;
-      getline(input_stream, line);
-      for (int i = 0; i < line.size(); i++) {
-        acre_type_e type = acre_type_e::ground;
-        switch (line[i]) {
-          case '|':
-            type = acre_type_e::trees;
-            break;
-          case '#':
-            type = acre_type_e::lumberyard;
-            break;
-        }
-        row.push_back(type);
-      }
-      outdata.acres.push_back(row);
+  long get_resource_value_after(area_t &area, int minutes) {
+    instrument::scoped_timer_t timer(resource_timer);
+    for (int i = 0; i < minutes; i++) {
+      area.tick_one_minute();
     }
+    return area.get_resource_value();
   }
 
   void problem1() {
@@ -192,16 +107,21 @@ namespace day18 {
         std::cout << area << std::endl;
       }
       assert(area.get_resource_value() == 1147);
+
+      area_t ticked, fast_forwarded;
+      read_day18_data(ticked, "data/day18/problem1/test1.txt");
+      read_day18_data(fast_forwarded, "data/day18/problem1/test1.txt");
+      get_resource_value_after(ticked, 1000);
+      fast_forwarded.fast_forward_to(1000);
+      assert(fast_forwarded.minute == 1000 && fast_forwarded.acres.cells == ticked.acres.cells);
     }
 
     area_t area;
-    read_day18_data(area, "data/day18/problem1/input.txt");
+    read_day18_data(area, input::resolve_path(18, "data/day18/problem1/input.txt"));
     std::cout << area << std::endl;
-    for (int i = 0; i < 10; i++) {
-      area.tick_one_minute();
-    }
+    long result = get_resource_value_after(area, 10);
     std::cout << area << std::endl;
-    std::cout << "Result: " << area.get_resource_value() << std::endl;
+    std::cout << "Result: " << result << std::endl;
 
 #endif
   }
@@ -211,48 +131,10 @@ namespace day18 {
 #if !defined(ONLY_ACTIVATE) || ONLY_ACTIVATE == 18
 
     area_t area;
-    read_day18_data(area, "data/day18/problem2/input.txt");
-    for (int i = 0; i < 700; i++) {
-      area.tick_one_minute();
-      // if ((i + 1) % 100 == 0) {
-      std::cout << std::setw(10) << (i + 1) << ": " << area.get_resource_value() << std::endl;
-      // }
-    }
-
-    // This one requires looking at the repeating pattern in the output
-    // The following pattern repeats indefinitely after (including) 672
-    std::vector<int> pattern = {
-      176782,
-      175212,
-      173290,
-      173658,
-      173922,
-      177815,
-      182358,
-      186042,
-      192504,
-      195308,
-      200646,
-      205120,
-      208650,
-      210588,
-      212833,
-      212688,
-      212443,
-      208278,
-      200466,
-      196680,
-      195290,
-      189980,
-      186795,
-      184392,
-      180560,
-      181383,
-      182700,
-      180942
-    };
-
-    int result = pattern[(1000000000 - 672) % pattern.size()];
+    read_day18_data(area, input::resolve_path(18, "data/day18/problem2/input.txt"));
+    // The acres settle into a cycle long before the billionth minute
+    area.fast_forward_to(1000000000);
+    long result = area.get_resource_value();
     std::cout << "Result: " << result << std::endl;
 
 #endif
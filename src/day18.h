@@ -0,0 +1,209 @@
+#ifndef ADVENT_OF_CODE_2018_DAY18_H
+#define ADVENT_OF_CODE_2018_DAY18_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <regex>
+#include <limits>
+#include <array>
+#include <sstream>
+#include <cstdint>
+#include <thread>
+#include "instrument.h"
+#include "grid2d.h"
+
+namespace day18 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+  const bool enable_assertions = true;
+
+  inline instrument::counter_t minutes_run{"day18.minutes"};
+  inline instrument::counter_t acres_evaluated{"day18.acres_evaluated"};
+  inline instrument::timer_stats_t resource_timer{"day18.resource_value_after"};
+
+  // Maps with at least this many acres tick their rows on several threads
+  const int parallel_tick_min_acres = 256 * 1024;
+
+  enum acre_type_e : uint8_t {
+    ground,
+    trees,
+    lumberyard,
+  };
+
+  struct surrounding_area_t {
+    int num_trees = 0;
+    int num_lumberyards = 0;
+    int num_ground = 0;
+
+    // The area's border is open ground, so acres on the edge count it as ground
+    surrounding_area_t(const grid2d::grid2d_t<acre_type_e> &acres, int x, int y) {
+      // Row above
+      auto *row_above = acres.row(y - 1);
+      count_acre(row_above[x - 1]);
+      count_acre(row_above[x]);
+      count_acre(row_above[x + 1]);
+      // Same row
+      auto *row = acres.row(y);
+      count_acre(row[x - 1]);
+      count_acre(row[x + 1]);
+      // Row below
+      auto *row_below = acres.row(y + 1);
+      count_acre(row_below[x - 1]);
+      count_acre(row_below[x]);
+      count_acre(row_below[x + 1]);
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const surrounding_area_t &surround_area) {
+      out << ".(" << surround_area.num_ground << ") |(" << surround_area.num_trees << ") #("
+          << surround_area.num_lumberyards << ")";
+      return out;
+    }
+
+  private:
+    void count_acre(acre_type_e type) {
+      switch (type) {
+        case acre_type_e::ground:
+          num_ground++;
+          break;
+        case acre_type_e::lumberyard:
+          num_lumberyards++;
+          break;
+        case acre_type_e::trees:
+          num_trees++;
+          break;
+      }
+    }
+  };
+
+  struct area_t {
+    // Padded by one acre of open ground so every acre has 8 neighbours
+    grid2d::grid2d_t<acre_type_e> acres;
+    grid2d::grid2d_t<acre_type_e> write_state;
+    long minute = 0;
+
+    // Writes the next state of rows [y_begin, y_end) into write_state
+    void tick_rows(int y_begin, int y_end);
+
+    // Double-buffered: every acre of write_state is rewritten from acres, then the buffers swap
+    void tick_one_minute() {
+      if (write_state.width != acres.width || write_state.height != acres.height) write_state = acres;
+
+      unsigned num_threads = 1;
+      if (!trace1 && static_cast<long>(acres.width) * acres.height >= parallel_tick_min_acres) {
+        num_threads = std::min(std::thread::hardware_concurrency(), static_cast<unsigned>(acres.height / 64));
+        num_threads = std::max(1u, num_threads);
+      }
+      if (num_threads == 1) {
+        tick_rows(0, acres.height);
+      } else {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < num_threads; t++) {
+          int y_begin = static_cast<int>(static_cast<long>(acres.height) * t / num_threads);
+          int y_end = static_cast<int>(static_cast<long>(acres.height) * (t + 1) / num_threads);
+          workers.emplace_back([this, y_begin, y_end]() { tick_rows(y_begin, y_end); });
+        }
+        for (auto &w : workers) {
+          w.join();
+        }
+      }
+      std::swap(acres, write_state);
+      minute++;
+      minutes_run.add();
+    }
+
+    size_t hash_acres() const {
+      size_t h = 14695981039346656037ull;
+      for (auto type : acres.cells) {
+        h = (h ^ static_cast<size_t>(type)) * 1099511628211ull;
+      }
+      return h;
+    }
+
+    // Ticks until target_minute, skipping whole cycles once the acres repeat. The period is found with Brent's
+    // algorithm: a saved state is compared (by hash, then cell by cell) against each new minute and moved forward
+    // whenever the search window doubles, so only one extra copy of the acres is kept.
+    void fast_forward_to(long target_minute) {
+      if (minute >= target_minute) return;
+
+      auto tortoise = acres;
+      size_t tortoise_hash = hash_acres();
+      long power = 1, period = 1;
+      tick_one_minute();
+      while (minute < target_minute) {
+        size_t hash = hash_acres();
+        if (hash == tortoise_hash && acres.cells == tortoise.cells) {
+          // Every state from here on repeats after period minutes
+          if (trace2) std::cout << "Acres repeat every " << period << " minutes from minute " << minute << std::endl;
+          long remaining = (target_minute - minute) % period;
+          minute = target_minute - remaining;
+          for (long i = 0; i < remaining; i++) {
+            tick_one_minute();
+          }
+          return;
+        }
+        if (power == period) {
+          tortoise = acres;
+          tortoise_hash = hash;
+          power *= 2;
+          period = 0;
+        }
+        tick_one_minute();
+        period++;
+      }
+    }
+
+    long get_resource_value() {
+      long num_wooded_areas = 0, num_lumberyards = 0;
+      acres.for_each([&](int, int, acre_type_e type) {
+        if (type == acre_type_e::trees) {
+          num_wooded_areas++;
+        } else if (type == acre_type_e::lumberyard) {
+          num_lumberyards++;
+        }
+      });
+      return num_wooded_areas * num_lumberyards;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const area_t &area) {
+      for (int y = 0; y < area.acres.height; y++) {
+        auto *row = area.acres.row(y);
+        for (int x = 0; x < area.acres.width; x++) {
+          switch (row[x]) {
+            case acre_type_e::ground:
+              out << ".";
+              break;
+            case acre_type_e::lumberyard:
+              out << "#";
+              break;
+            case acre_type_e::trees:
+              out << "|";
+              break;
+          }
+        }
+        out << std::endl;
+      }
+      out << std::endl;
+      return out;
+    }
+  };
+
+  void read_day18_data(area_t &outdata, const char *filepath);
+
+  // Ticks the area for the given minutes and returns the resulting resource value
+  long get_resource_value_after(area_t &area, int minutes);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY18_H
@@ -1,18 +1,14 @@
-#include <iostream>
-#include <vector>
-#include <fstream>
-#include <map>
+#include "day2.h"
+#include "input.h"
 
 namespace day2 {
 
-  const bool trace1 = false;
-  const bool trace2 = false;
-
   void read_day2_data(std::vector<std::string> &outdata, const char *filepath) {
-    std::ifstream inputStream(filepath);
-    std::string line;
-    while (std::getline(inputStream, line)) {
-      outdata.push_back(line);
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::string_view line;
+    while (input::next_line(text, line)) {
+      outdata.emplace_back(line);
     }
   }
 
@@ -108,7 +104,7 @@ namespace day2 {
     assert(get_box_ids_checksum(test1) == 12);
 
     std::vector<std::string> input;
-    read_day2_data(input, "data/day2/problem1/input.txt");
+    read_day2_data(input, input::resolve_path(2, "data/day2/problem1/input.txt"));
     std::cout << "Result : " << get_box_ids_checksum(input) << std::endl;
 
 #endif
@@ -123,7 +119,7 @@ namespace day2 {
     assert(get_prototype_fabric_box_common_letters(test1) == "fgij");
 
     std::vector<std::string> input;
-    read_day2_data(input, "data/day2/problem2/input.txt");
+    read_day2_data(input, input::resolve_path(2, "data/day2/problem2/input.txt"));
     std::cout << "Result : " << get_prototype_fabric_box_common_letters(input) << std::endl;
 
 #endif
@@ -0,0 +1,29 @@
+#ifndef ADVENT_OF_CODE_2018_DAY2_H
+#define ADVENT_OF_CODE_2018_DAY2_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <map>
+
+namespace day2 {
+
+  const bool trace1 = false;
+  const bool trace2 = false;
+
+  void read_day2_data(std::vector<std::string> &outdata, const char *filepath);
+
+  int get_box_ids_checksum(std::vector<std::string> &input);
+
+  // Returns hamming distance and the last character index that was different
+  std::pair<int, int> hamming_distance(const std::string &s1, const std::string &s2);
+
+  std::string get_prototype_fabric_box_common_letters(std::vector<std::string> &input);
+
+  void problem1();
+
+  void problem2();
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY2_H
@@ -0,0 +1,39 @@
+#ifndef ADVENT_OF_CODE_2018_DAY21_H
+#define ADVENT_OF_CODE_2018_DAY21_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <regex>
+#include <limits>
+#include <array>
+#include <sstream>
+#include "device.h"
+
+namespace day21 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+  const bool enable_assertions = true;
+
+  // The device is shared with days 16 and 19
+  using device::instruction_t;
+  using device::program_t;
+  using device::device_state_t;
+  using device::device_t;
+
+  void read_day21_program_data(program_t &outdata, const char *filepath);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY21_H
@@ -0,0 +1,129 @@
+#ifndef ADVENT_OF_CODE_2018_DAY23_H
+#define ADVENT_OF_CODE_2018_DAY23_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <memory>
+#include <limits>
+#include <array>
+#include <sstream>
+#include <cmath>
+#include "scanner.h"
+#include "instrument.h"
+
+namespace day23 {
+
+  const bool trace_read = false;
+  const bool trace1 = true;
+  const bool trace2 = false;
+  const bool enable_assertions = true;
+
+  inline instrument::counter_t containment_checks{"day23.containment_checks"};
+  inline instrument::timer_stats_t intersection_search_timer{"day23.find_distance_with_max_intersections"};
+
+  using val_t = long;
+
+  inline val_t compute_manhattan_distance(val_t x1, val_t y1, val_t z1, val_t x2, val_t y2, val_t z2) {
+    return std::abs(x1 - x2) + std::abs(y1 - y2) + std::abs(z1 - z2);
+  }
+
+  struct point3 {
+    val_t x, y, z;
+
+    val_t distance_from_origin() {
+      return compute_manhattan_distance(0, 0, 0, x, y, z);
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const point3 &pt) {
+      out << "(" << pt.x << "," << pt.y << "," << pt.z << ")";
+      return out;
+    }
+  };
+
+  struct nanobot_t {
+    point3 coord;
+    val_t radius;
+
+    bool contains(const point3 &pt) {
+      auto dist = compute_manhattan_distance(pt.x, pt.y, pt.z, coord.x, coord.y, coord.z);
+      return dist <= radius;
+    }
+
+    friend void parse(std::string_view line, nanobot_t &nanobot) {
+      assert(!line.empty());
+
+      // pos=<0,0,0>, r=4
+      scanner::scanner_t scan(line);
+      if (!(scan.literal("pos=<") && scan.number(nanobot.coord.x) && scan.literal(",") &&
+            scan.number(nanobot.coord.y) && scan.literal(",") && scan.number(nanobot.coord.z) &&
+            scan.literal(">, r=") && scan.number(nanobot.radius))) {
+        throw new std::invalid_argument("Cannot parse nanobot!");
+      }
+
+      if (trace_read) {
+        std::cout << nanobot << std::endl;
+      }
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const nanobot_t &nanobot) {
+      std::cout << "pos=<" << nanobot.coord.x << "," << nanobot.coord.y << "," << nanobot.coord.z << ">, r=" << nanobot.radius;
+      return out;
+    }
+  };
+
+  struct env_t {
+    std::vector<std::shared_ptr<nanobot_t>> nanobots;
+
+    env_t(const std::vector<nanobot_t> &_nanobots) {
+      for (auto &_nanobot : _nanobots) {
+        auto nanobot = std::make_shared<nanobot_t>();
+        *nanobot = _nanobot;
+        nanobots.push_back(nanobot);
+      }
+    }
+
+    std::shared_ptr<nanobot_t> find_nanobot_with_largest_radius() {
+      val_t max_radius = 0;
+      std::shared_ptr<nanobot_t> nanobot_with_largest_radius = nullptr;
+      for (const auto &nanobot : nanobots) {
+        if (nanobot->radius > max_radius) {
+          max_radius = nanobot->radius;
+          nanobot_with_largest_radius = nanobot;
+        }
+      }
+      return nanobot_with_largest_radius;
+    }
+
+    val_t find_nanobots_in_range_of(nanobot_t *nanobot) {
+      int in_range_count = 0;
+      for (const auto &other_nanobot : nanobots) {
+        auto dist = compute_manhattan_distance(
+          nanobot->coord.x, nanobot->coord.y, nanobot->coord.z,
+          other_nanobot->coord.x, other_nanobot->coord.y, other_nanobot->coord.z
+        );
+        if (dist <= nanobot->radius) {
+          in_range_count++;
+        }
+      }
+      return in_range_count;
+    }
+  };
+
+  void read_day23_data(std::vector<nanobot_t> &outdata, const char *filepath);
+
+  // Distance from the origin of the best covered point found among the corners of every nanobot's range
+  val_t find_distance_with_max_intersections(env_t &env);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY23_H
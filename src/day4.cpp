@@ -1,172 +1,15 @@
-#include <iostream>
-#include <fstream>
-#include <vector>
-#include <array>
-#include <regex>
-#include <map>
-#include <memory>
+#include "day4.h"
+#include "input.h"
 
 namespace day4 {
 
-  const bool trace_read = false;
-  const bool trace1 = false;
-  const bool trace2 = false;
-
-  enum class guard_action_e {
-    BEGIN_SHIFT, WAKE_UP, FALL_ASLEEP
-  };
-
-  struct guard_event_t {
-    int guard_id = -1; // May not be available
-    guard_action_e action;
-    int year, month, day;
-    int hour, minute;
-
-    bool operator<(const guard_event_t &other) const {
-      if (year < other.year) return true;
-      else if (year == other.year) {
-        if (month < other.month) return true;
-        else if (month == other.month) {
-          if (day < other.day) return true;
-          else if (day == other.day) {
-            if (hour < other.hour) return true;
-            else if (hour == other.hour) {
-              return (minute < other.minute);
-            }
-          }
-        }
-      }
-      return false;
-    }
-
-    friend std::istream &operator>>(std::istream &in, guard_event_t &ge) {
-      /** E.g.
-          [1518-10-28 23:51] Guard #1283 begins shift
-          [1518-10-11 00:29] wakes up
-          [1518-07-15 00:37] falls asleep
-      **/
-      std::string temp_str;
-      char temp_char;
-
-      std::string line;
-      getline(in, line);
-
-      std::regex timestamp_pattern(R"(\[(\d{4})\-(\d{2})\-(\d{2}) (\d{2}):(\d{2})\] (.*))");
-      std::smatch timestamp_matches;
-
-      if (!std::regex_search(line, timestamp_matches, timestamp_pattern)) {
-        throw new std::invalid_argument("Cannot parse timestamp!");
-      }
-
-      ge.year = std::stoi(timestamp_matches[1].str());
-      ge.month = std::stoi(timestamp_matches[2].str());
-      ge.day = std::stoi(timestamp_matches[3].str());
-      ge.hour = std::stoi(timestamp_matches[4].str());
-      ge.minute = std::stoi(timestamp_matches[5].str());
-
-      std::string action = timestamp_matches[6].str();
-      std::regex begin_shift_pattern(R"(Guard #(\d+) begins shift)");
-      std::regex wake_up_pattern(R"(wakes up)");
-      std::regex fall_asleep_pattern(R"(falls asleep)");
-      std::smatch action_matches;
-
-      if (std::regex_search(action, action_matches, begin_shift_pattern)) {
-        ge.action = guard_action_e::BEGIN_SHIFT;
-        ge.guard_id = std::stoi(action_matches[1].str());
-      } else if (std::regex_search(action, action_matches, wake_up_pattern)) {
-        ge.action = guard_action_e::WAKE_UP;
-      } else if (std::regex_search(action, action_matches, fall_asleep_pattern)) {
-        ge.action = guard_action_e::FALL_ASLEEP;
-      }
-
-      if (trace_read) std::cout << "Read " << ge << std::endl;
-      return in;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, guard_event_t &ge) {
-      out << "[" << ge.year << "-" << ge.month << "-" << ge.day << " " << ge.hour << ":" << ge.minute << "] ";
-      switch (ge.action) {
-        case guard_action_e::BEGIN_SHIFT: {
-          out << "Guard #" << ge.guard_id << " begins shift";
-          break;
-        }
-        case guard_action_e::WAKE_UP: {
-          out << "wakes up";
-          break;
-        }
-        case guard_action_e::FALL_ASLEEP: {
-          out << "falls asleep";
-          break;
-        }
-        default: {
-          break;
-        }
-      }
-      return out;
-    }
-  };
-
-  struct guard_schedule_t {
-    std::array<bool, 60> minutes_asleep{false};
-
-    void sleeping_from(int minute) {
-      for (int i = minute; i < 60; i++) {
-        minutes_asleep[i] = true;
-      }
-    }
-
-    void awake_from(int minute) {
-      for (int i = minute; i < 60; i++) {
-        minutes_asleep[i] = false;
-      }
-    }
-
-    int get_minutes_slept() {
-      int result = 0;
-      for (auto &slept : minutes_asleep) {
-        result += (slept ? 1 : 0);
-      }
-      return result;
-    }
-  };
-
-  struct guard_t {
-    int guard_id;
-    std::vector<guard_schedule_t> schedules;
-
-    guard_t(int gid = -1) : guard_id(gid) {}
-
-    void add_schedule(const guard_schedule_t &schedule) {
-      schedules.push_back(schedule);
-    }
-
-    int get_minutes_slept() {
-      int minutes_slept = 0;
-      for (auto &schedule : schedules) {
-        minutes_slept += schedule.get_minutes_slept();
-      }
-      return minutes_slept;
-    }
-
-    std::pair<int, int> find_minute_slept_the_most() {
-      std::array<int, 60> slept_instances{0};
-      for (auto &schedule : schedules) {
-        for (int i = 0; i < 60; i++) {
-          slept_instances[i] += (schedule.minutes_asleep[i] ? 1 : 0);
-        }
-      }
-      int minute = std::distance(slept_instances.begin(),
-                                 std::max_element(slept_instances.begin(), slept_instances.end()));
-      int times_slept = slept_instances[minute];
-      return {minute, times_slept};
-    }
-  };
-
   void read_day4_data(std::vector<guard_event_t> &outdata, const char *filepath) {
-    std::ifstream inputStream(filepath);
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::string_view line;
     guard_event_t guard_event;
-    while (!inputStream.eof()) {
-      inputStream >> guard_event;
+    while (input::next_line(text, line)) {
+      parse(line, guard_event);
       outdata.push_back(guard_event);
     }
   }
@@ -316,7 +159,7 @@ namespace day4 {
     assert((guard_id * minute) == 240);
 
     std::vector<guard_event_t> input;
-    read_day4_data(input, "data/day4/problem1/input.txt");
+    read_day4_data(input, input::resolve_path(4, "data/day4/problem1/input.txt"));
     auto[guard_id2, minute2] = find_guard_and_minute1(input);
     std::cout << "Result : " << (guard_id2 * minute2) << std::endl;
 
@@ -333,7 +176,7 @@ namespace day4 {
     assert((guard_id * minute) == 4455);
 
     std::vector<guard_event_t> input;
-    read_day4_data(input, "data/day4/problem2/input.txt");
+    read_day4_data(input, input::resolve_path(4, "data/day4/problem2/input.txt"));
     auto[guard_id2, minute2] = find_guard_and_minute2(input);
     std::cout << "Result : " << (guard_id2 * minute2) << std::endl;
 
@@ -0,0 +1,163 @@
+#ifndef ADVENT_OF_CODE_2018_DAY4_H
+#define ADVENT_OF_CODE_2018_DAY4_H
+
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include "scanner.h"
+
+namespace day4 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = false;
+
+  enum class guard_action_e {
+    BEGIN_SHIFT, WAKE_UP, FALL_ASLEEP
+  };
+
+  struct guard_event_t {
+    int guard_id = -1; // May not be available
+    guard_action_e action;
+    int year, month, day;
+    int hour, minute;
+
+    bool operator<(const guard_event_t &other) const {
+      if (year < other.year) return true;
+      else if (year == other.year) {
+        if (month < other.month) return true;
+        else if (month == other.month) {
+          if (day < other.day) return true;
+          else if (day == other.day) {
+            if (hour < other.hour) return true;
+            else if (hour == other.hour) {
+              return (minute < other.minute);
+            }
+          }
+        }
+      }
+      return false;
+    }
+
+    friend void parse(std::string_view line, guard_event_t &ge) {
+      /** E.g.
+          [1518-10-28 23:51] Guard #1283 begins shift
+          [1518-10-11 00:29] wakes up
+          [1518-07-15 00:37] falls asleep
+      **/
+      scanner::scanner_t scan(line);
+      if (!(scan.literal("[") && scan.number(ge.year) && scan.literal("-") && scan.number(ge.month) &&
+            scan.literal("-") && scan.number(ge.day) && scan.number(ge.hour) && scan.literal(":") &&
+            scan.number(ge.minute) && scan.literal("] "))) {
+        throw new std::invalid_argument("Cannot parse timestamp!");
+      }
+
+      if (scan.attempt([&ge](scanner::scanner_t &s) {
+            return s.literal("Guard #") && s.number(ge.guard_id) && s.literal(" begins shift");
+          })) {
+        ge.action = guard_action_e::BEGIN_SHIFT;
+      } else if (scan.literal("wakes up")) {
+        ge.action = guard_action_e::WAKE_UP;
+      } else if (scan.literal("falls asleep")) {
+        ge.action = guard_action_e::FALL_ASLEEP;
+      }
+
+      if (trace_read) std::cout << "Read " << ge << std::endl;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, guard_event_t &ge) {
+      out << "[" << ge.year << "-" << ge.month << "-" << ge.day << " " << ge.hour << ":" << ge.minute << "] ";
+      switch (ge.action) {
+        case guard_action_e::BEGIN_SHIFT: {
+          out << "Guard #" << ge.guard_id << " begins shift";
+          break;
+        }
+        case guard_action_e::WAKE_UP: {
+          out << "wakes up";
+          break;
+        }
+        case guard_action_e::FALL_ASLEEP: {
+          out << "falls asleep";
+          break;
+        }
+        default: {
+          break;
+        }
+      }
+      return out;
+    }
+  };
+
+  struct guard_schedule_t {
+    std::array<bool, 60> minutes_asleep{false};
+
+    void sleeping_from(int minute) {
+      for (int i = minute; i < 60; i++) {
+        minutes_asleep[i] = true;
+      }
+    }
+
+    void awake_from(int minute) {
+      for (int i = minute; i < 60; i++) {
+        minutes_asleep[i] = false;
+      }
+    }
+
+    int get_minutes_slept() {
+      int result = 0;
+      for (auto &slept : minutes_asleep) {
+        result += (slept ? 1 : 0);
+      }
+      return result;
+    }
+  };
+
+  struct guard_t {
+    int guard_id;
+    std::vector<guard_schedule_t> schedules;
+
+    guard_t(int gid = -1) : guard_id(gid) {}
+
+    void add_schedule(const guard_schedule_t &schedule) {
+      schedules.push_back(schedule);
+    }
+
+    int get_minutes_slept() {
+      int minutes_slept = 0;
+      for (auto &schedule : schedules) {
+        minutes_slept += schedule.get_minutes_slept();
+      }
+      return minutes_slept;
+    }
+
+    std::pair<int, int> find_minute_slept_the_most() {
+      std::array<int, 60> slept_instances{0};
+      for (auto &schedule : schedules) {
+        for (int i = 0; i < 60; i++) {
+          slept_instances[i] += (schedule.minutes_asleep[i] ? 1 : 0);
+        }
+      }
+      int minute = std::distance(slept_instances.begin(),
+                                 std::max_element(slept_instances.begin(), slept_instances.end()));
+      int times_slept = slept_instances[minute];
+      return {minute, times_slept};
+    }
+  };
+
+  void read_day4_data(std::vector<guard_event_t> &outdata, const char *filepath);
+
+  std::pair<int, int> find_guard_and_minute1(std::vector<guard_event_t> &input);
+
+  std::pair<int, int> find_guard_and_minute2(std::vector<guard_event_t> &input);
+
+  void problem1();
+
+  void problem2();
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY4_H
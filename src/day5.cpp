@@ -1,19 +1,14 @@
-#include <iostream>
-#include <fstream>
-#include <cctype>   // islower, toupper, tolower
-#include <limits>
-#include <set>
-#include <vector>
+#include "day5.h"
+#include "input.h"
 
 namespace day5 {
 
   // Do the processing while reading from stream
 
   std::vector<char> get_unique_units(const char *filepath) {
-    std::ifstream input_stream(filepath);
+    input::mapped_file_t input(filepath);
     std::set<char> unique_units;
-    char unit;
-    while (input_stream.get(unit)) {
+    for (char unit : input.contents()) {
       unique_units.insert(unit);
     }
     std::vector<char> unique_units_arr;
@@ -21,15 +16,14 @@ namespace day5 {
     return unique_units_arr;
   }
 
-  int get_polymer_length_after_reactions(const char *filepath, char remove_unit = 0) {
-    std::ifstream input_stream(filepath);
+  int get_polymer_length_after_reactions(const char *filepath, char remove_unit) {
+    input::mapped_file_t input(filepath);
     std::string buffer;
 
     char remove_unit_upper = toupper(remove_unit);
     char remove_unit_lower = tolower(remove_unit);
 
-    char current_unit;
-    while (input_stream.get(current_unit)) {
+    for (char current_unit : input.contents()) {
       if (current_unit == remove_unit_lower || current_unit == remove_unit_upper) {
         continue;
       }
@@ -78,7 +72,8 @@ namespace day5 {
 
     assert(get_polymer_length_after_reactions("data/day5/problem1/test1.txt") == 10);
 
-    std::cout << "Result : " << get_polymer_length_after_reactions("data/day5/problem1/input.txt") << std::endl;
+    auto input_path = input::resolve_path(5, "data/day5/problem1/input.txt");
+    std::cout << "Result : " << get_polymer_length_after_reactions(input_path) << std::endl;
 
 #endif
   }
@@ -89,8 +84,8 @@ namespace day5 {
 
     assert(get_shortest_polymer_length_after_removing_single_unit("data/day5/problem2/test1.txt") == 4);
 
-    std::cout << "Result : " << get_shortest_polymer_length_after_removing_single_unit("data/day5/problem2/input.txt")
-              << std::endl;
+    auto input_path = input::resolve_path(5, "data/day5/problem2/input.txt");
+    std::cout << "Result : " << get_shortest_polymer_length_after_removing_single_unit(input_path) << std::endl;
 
 #endif
   }
@@ -0,0 +1,27 @@
+#ifndef ADVENT_OF_CODE_2018_DAY5_H
+#define ADVENT_OF_CODE_2018_DAY5_H
+
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <cctype>   // islower, toupper, tolower
+#include <limits>
+#include <set>
+#include <vector>
+
+namespace day5 {
+
+  // Do the processing while reading from stream
+  std::vector<char> get_unique_units(const char *filepath);
+
+  int get_polymer_length_after_reactions(const char *filepath, char remove_unit = 0);
+
+  int get_shortest_polymer_length_after_removing_single_unit(const char *filepath);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY5_H
@@ -1,118 +1,11 @@
-#include <iostream>
-#include <fstream>
-#include <cctype>   // islower, toupper, tolower
-#include <limits>
-#include <set>
-#include <vector>
-#include <memory>
-#include <cmath>
-#include <algorithm>
+#include "day6.h"
+#include "input.h"
 
 namespace day6 {
 
-  const bool trace_read = false;
-  const bool trace1 = false;
-
-  struct point_t {
-    int index;
-    int x, y;
-
-    point_t(int index) : index(index) {}
-
-    friend std::istream &operator>>(std::istream &in, point_t &point) {
-      // E.g. 3, 4
-      char temp_char;
-      in >> point.x >> temp_char >> point.y;
-
-      if (trace_read) std::cout << "Read " << point << std::endl;
-      return in;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, point_t &point) {
-      out << "[" << point.index << "] (" << point.x << ", " << point.y << ")";
-      return out;
-    }
-  };
-
-  struct point_distance_t {
-    std::shared_ptr<point_t> point;
-    int distance;
-    bool shared;
-
-    point_distance_t() : point(nullptr), distance(-1), shared(false) {}
-  };
-
-  int compute_manhattan_distance(int x1, int y1, int x2, int y2) {
-    return std::abs(x1 - x2) + std::abs(y1 - y2);
-  }
-
-  struct grid_t {
-    int width, height;
-    std::vector<std::vector<point_distance_t>> point_distances;
-
-    grid_t(int width, int height) : width(width), height(height) {
-      if (trace_read) std::cout << "Creating grid " << width << "x" << height << std::endl;
-      point_distances.resize(height, std::vector<point_distance_t>(width));
-    }
-
-    void add_point(std::shared_ptr<point_t> point) {
-      for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-          auto &pd = point_distances[y][x];
-          auto new_distance = compute_manhattan_distance(point->x, point->y, x, y);
-          point_distance_t new_pd;
-          new_pd.point = point;
-          new_pd.distance = new_distance;
-          new_pd.shared = false;
-
-          if (!pd.point) {
-            // No points in grid cell; add cell regardless of distance
-            point_distances[y][x] = new_pd;
-          } else {
-            // Point exists in grid
-            // If registered distance >= incoming distance then replace with incoming point
-            if (pd.distance >= new_distance) {
-              // And if registered distance == incoming distance set the shared to true
-              if (pd.distance == new_distance) {
-                new_pd.shared = true;
-              }
-              point_distances[y][x] = new_pd;
-            }
-          }
-        }
-      }
-    }
-
-    void visit_all(std::function<void(int, int, const point_distance_t &)> visitor) {
-      for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-          visitor(x, y, point_distances[y][x]);
-        }
-      }
-    }
-
-    void visit_perimeter(std::function<void(int, int, const point_distance_t &)> visitor) {
-      // Top
-      for (int x = 0; x < width; x++) {
-        visitor(x, 0, point_distances[0][x]);
-      }
-      // Right
-      for (int y = 1; y < height; y++) {
-        visitor(width - 1, y, point_distances[y][width - 1]);
-      }
-      // Bottom
-      for (int x = width - 2; x > -1; x--) {
-        visitor(x, height - 1, point_distances[height - 1][x]);
-      }
-      // Left
-      for (int y = height - 2; y > 0; y--) {
-        visitor(0, y, point_distances[y][0]);
-      }
-    }
-  };
-
   void read_day6_data(std::vector<std::shared_ptr<point_t>> &outdata, const char *filepath) {
-    std::ifstream inputStream(filepath);
+    input::mapped_file_t input(filepath);
+    input::view_istream_t inputStream(input.contents());
     int index = 0;
     while (!inputStream.eof()) {
       point_t point = {index++};
@@ -214,7 +107,7 @@ namespace day6 {
     assert(find_largest_finite_area(test1) == 17);
 
     std::vector<std::shared_ptr<point_t>> input;
-    read_day6_data(input, "data/day6/problem1/input.txt");
+    read_day6_data(input, input::resolve_path(6, "data/day6/problem1/input.txt"));
     std::cout << "Result : " << find_largest_finite_area(input) << std::endl;
 
 #endif
@@ -229,7 +122,7 @@ namespace day6 {
     assert(find_area_size_within_limit(test1, 32) == 16);
 
     std::vector<std::shared_ptr<point_t>> input;
-    read_day6_data(input, "data/day6/problem2/input.txt");
+    read_day6_data(input, input::resolve_path(6, "data/day6/problem2/input.txt"));
     std::cout << "Result : " << find_area_size_within_limit(input, 10000) << std::endl;
 
 #endif
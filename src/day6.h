@@ -0,0 +1,129 @@
+#ifndef ADVENT_OF_CODE_2018_DAY6_H
+#define ADVENT_OF_CODE_2018_DAY6_H
+
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <cctype>   // islower, toupper, tolower
+#include <limits>
+#include <set>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include "grid2d.h"
+
+namespace day6 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+
+  struct point_t {
+    int index;
+    int x, y;
+
+    point_t(int index) : index(index) {}
+
+    friend std::istream &operator>>(std::istream &in, point_t &point) {
+      // E.g. 3, 4
+      char temp_char;
+      in >> point.x >> temp_char >> point.y;
+
+      if (trace_read) std::cout << "Read " << point << std::endl;
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, point_t &point) {
+      out << "[" << point.index << "] (" << point.x << ", " << point.y << ")";
+      return out;
+    }
+  };
+
+  struct point_distance_t {
+    const point_t *point;   // Owned by the input list
+    int distance;
+    bool shared;
+
+    point_distance_t() : point(nullptr), distance(-1), shared(false) {}
+  };
+
+  inline int compute_manhattan_distance(int x1, int y1, int x2, int y2) {
+    return std::abs(x1 - x2) + std::abs(y1 - y2);
+  }
+
+  struct grid_t {
+    int width, height;
+    grid2d::grid2d_t<point_distance_t> point_distances;
+
+    grid_t(int width, int height) : width(width), height(height) {
+      if (trace_read) std::cout << "Creating grid " << width << "x" << height << std::endl;
+      point_distances.resize(width, height);
+    }
+
+    void add_point(std::shared_ptr<point_t> point) {
+      for (int y = 0; y < height; y++) {
+        auto *row = point_distances.row(y);
+        for (int x = 0; x < width; x++) {
+          auto &pd = row[x];
+          auto new_distance = compute_manhattan_distance(point->x, point->y, x, y);
+          point_distance_t new_pd;
+          new_pd.point = point.get();
+          new_pd.distance = new_distance;
+          new_pd.shared = false;
+
+          if (!pd.point) {
+            // No points in grid cell; add cell regardless of distance
+            pd = new_pd;
+          } else {
+            // Point exists in grid
+            // If registered distance >= incoming distance then replace with incoming point
+            if (pd.distance >= new_distance) {
+              // And if registered distance == incoming distance set the shared to true
+              if (pd.distance == new_distance) {
+                new_pd.shared = true;
+              }
+              pd = new_pd;
+            }
+          }
+        }
+      }
+    }
+
+    void visit_all(std::function<void(int, int, const point_distance_t &)> visitor) {
+      point_distances.for_each(visitor);
+    }
+
+    void visit_perimeter(std::function<void(int, int, const point_distance_t &)> visitor) {
+      // Top
+      for (int x = 0; x < width; x++) {
+        visitor(x, 0, point_distances.at(x, 0));
+      }
+      // Right
+      for (int y = 1; y < height; y++) {
+        visitor(width - 1, y, point_distances.at(width - 1, y));
+      }
+      // Bottom
+      for (int x = width - 2; x > -1; x--) {
+        visitor(x, height - 1, point_distances.at(x, height - 1));
+      }
+      // Left
+      for (int y = height - 2; y > 0; y--) {
+        visitor(0, y, point_distances.at(0, y));
+      }
+    }
+  };
+
+  void read_day6_data(std::vector<std::shared_ptr<point_t>> &outdata, const char *filepath);
+
+  int find_largest_finite_area(std::vector<std::shared_ptr<point_t>> &input);
+
+  int find_area_size_within_limit(std::vector<std::shared_ptr<point_t>> &input, int limit);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY6_H
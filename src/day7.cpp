@@ -1,80 +1,15 @@
-#include <iostream>
-#include <fstream>
-#include <cctype>   // islower, toupper, tolower
-#include <limits>
-#include <set>
-#include <vector>
-#include <memory>
-#include <cmath>
-#include <algorithm>
-#include <regex>
-#include <map>
-#include <set>
-#include <list>
-#include <stack>
+#include "day7.h"
+#include "input.h"
 
 namespace day7 {
 
-  const bool trace_read = false;
-  const bool trace1 = false;
-  const bool trace2 = true;
-
-  struct step_rule_t {
-    char dependancy_step;
-    char step;
-
-    friend std::istream &operator>>(std::istream &in, step_rule_t &sr) {
-      // E.g.: Step C must be finished before step A can begin.
-      std::string line;
-      getline(in, line);
-
-      std::regex step_pattern(R"(Step ([A-Z]{1}) must be finished before step ([A-Z]{1}) can begin.)");
-      std::smatch step_matches;
-
-      if (!std::regex_search(line, step_matches, step_pattern)) {
-        throw new std::invalid_argument("Cannot parse step rule!");
-      }
-
-      sr.dependancy_step = step_matches[1].str()[0];
-      sr.step = step_matches[2].str()[0];
-
-      if (trace_read) std::cout << "Read " << sr << std::endl;
-      return in;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, step_rule_t &sr) {
-      out << "Step " << sr.dependancy_step << " must be finished before step " << sr.step << " can begin.";
-      return out;
-    }
-  };
-
-  struct step_t {
-    char id;
-    std::set<char> dependency_steps;
-
-    bool operator<(const step_t &other) const {
-      if (dependency_steps.size() < other.dependency_steps.size()) return true;
-      else if (dependency_steps.size() == other.dependency_steps.size()) {
-        return id < other.id;
-      }
-      return false;
-    }
-
-    friend std::ostream &operator<<(std::ostream &out, step_t &step) {
-      out << step.id << "[";
-      for (auto &dep : step.dependency_steps) {
-        out << dep;
-      }
-      out << "] ";
-      return out;
-    }
-  };
-
   void read_day7_data(std::vector<step_rule_t> &outdata, const char *filepath) {
-    std::ifstream inputStream(filepath);
+    input::mapped_file_t input(filepath);
+    auto text = input.contents();
+    std::string_view line;
     step_rule_t step_rule;
-    while (!inputStream.eof()) {
-      inputStream >> step_rule;
+    while (input::next_line(text, line)) {
+      parse(line, step_rule);
       outdata.push_back(step_rule);
     }
   }
@@ -127,18 +62,10 @@ namespace day7 {
       }
     }
 
-    std::cout << "Sequence: " << step_sequence << std::endl;
+    if (trace1) std::cout << "Sequence: " << step_sequence << std::endl;
     return step_sequence;
   }
 
-  struct worker_t {
-    bool is_idle;
-    int seconds_to_go;
-    char processing_step;
-
-    worker_t() : is_idle(true), seconds_to_go(0), processing_step(0) {}
-  };
-
   int find_step_sequence_runtime(std::vector<step_rule_t> &input, int num_workers, int runtime_shift) {
     std::map<char, std::set<char>> dependencies;
     for (auto &step_rule : input) {
@@ -230,7 +157,7 @@ namespace day7 {
     assert(find_step_sequence(test1) == "CABDFE");
 
     std::vector<step_rule_t> input;
-    read_day7_data(input, "data/day7/problem1/input.txt");
+    read_day7_data(input, input::resolve_path(7, "data/day7/problem1/input.txt"));
     std::cout << "Result : " << find_step_sequence(input) << std::endl;
 
 #endif
@@ -245,7 +172,7 @@ namespace day7 {
     assert(find_step_sequence_runtime(test1, 2, 0) == 15);
 
     std::vector<step_rule_t> input;
-    read_day7_data(input, "data/day7/problem2/input.txt");
+    read_day7_data(input, input::resolve_path(7, "data/day7/problem2/input.txt"));
     std::cout << "Result : " << find_step_sequence_runtime(input, 5, 60) << std::endl;
 
 #endif
@@ -0,0 +1,92 @@
+#ifndef ADVENT_OF_CODE_2018_DAY7_H
+#define ADVENT_OF_CODE_2018_DAY7_H
+
+#include <cassert>
+#include <iostream>
+#include <fstream>
+#include <cctype>   // islower, toupper, tolower
+#include <limits>
+#include <set>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <list>
+#include <stack>
+#include "scanner.h"
+
+namespace day7 {
+
+  const bool trace_read = false;
+  const bool trace1 = false;
+  const bool trace2 = true;
+
+  struct step_rule_t {
+    char dependancy_step;
+    char step;
+
+    friend void parse(std::string_view line, step_rule_t &sr) {
+      // E.g.: Step C must be finished before step A can begin.
+
+      const std::string_view step_names = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+      scanner::scanner_t scan(line);
+      if (!(scan.literal("Step ") && scan.one_of(step_names, sr.dependancy_step) &&
+            scan.literal(" must be finished before step ") && scan.one_of(step_names, sr.step) &&
+            scan.literal(" can begin."))) {
+        throw new std::invalid_argument("Cannot parse step rule!");
+      }
+
+      if (trace_read) std::cout << "Read " << sr << std::endl;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, step_rule_t &sr) {
+      out << "Step " << sr.dependancy_step << " must be finished before step " << sr.step << " can begin.";
+      return out;
+    }
+  };
+
+  struct step_t {
+    char id;
+    std::set<char> dependency_steps;
+
+    bool operator<(const step_t &other) const {
+      if (dependency_steps.size() < other.dependency_steps.size()) return true;
+      else if (dependency_steps.size() == other.dependency_steps.size()) {
+        return id < other.id;
+      }
+      return false;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, step_t &step) {
+      out << step.id << "[";
+      for (auto &dep : step.dependency_steps) {
+        out << dep;
+      }
+      out << "] ";
+      return out;
+    }
+  };
+
+  void read_day7_data(std::vector<step_rule_t> &outdata, const char *filepath);
+
+  std::string find_step_sequence(std::vector<step_rule_t> &input);
+
+  struct worker_t {
+    bool is_idle;
+    int seconds_to_go;
+    char processing_step;
+
+    worker_t() : is_idle(true), seconds_to_go(0), processing_step(0) {}
+  };
+
+  int find_step_sequence_runtime(std::vector<step_rule_t> &input, int num_workers, int runtime_shift);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY7_H
@@ -1,63 +1,12 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
+#include "day8.h"
+#include "input.h"
 
 namespace day8 {
 
-  struct tree_node_t {
-    std::vector<tree_node_t> children;
-    std::vector<int> metadata;
-
-    void parse(std::ifstream &input_stream) {
-      int num_children, num_metadata;
-      input_stream >> num_children >> num_metadata;
-      for (int i = 0; i < num_children; i++) {
-        tree_node_t child;
-        child.parse(input_stream);
-        children.push_back(child);
-      }
-      for (int i = 0; i < num_metadata; i++) {
-        int metadata_value;
-        input_stream >> metadata_value;
-        metadata.push_back(metadata_value);
-      }
-    }
-
-    void visit(std::function<void(const tree_node_t &)> visitor) const {
-      visitor(*this);
-      for (auto &child : children) {
-        child.visit(visitor);
-      }
-    }
-
-    int compute_value() {
-      if (children.empty()) {
-        int sum = 0;
-        for (auto &mval : metadata) {
-          sum += mval;
-        }
-        return sum;
-      } else {
-        // Sum of the values of the children specified by the metadata (child indices)
-        // If child index is out of bounds, skip
-        int sum = 0;
-        for (auto &cidx : metadata) {
-          if (cidx < 1 || cidx > children.size()) {
-            continue;
-          } else {
-            sum += children[cidx - 1].compute_value();
-          }
-        }
-        return sum;
-      }
-    }
-  };
-
   void read_day8_data(tree_node_t &outdata, const char *filepath) {
-    std::ifstream input_stream(filepath);
-    outdata.parse(input_stream);
+    input::mapped_file_t input(filepath);
+    scanner::scanner_t scan(input.contents());
+    outdata.parse(scan);
   }
 
   int sum_metadata(const tree_node_t &root) {
@@ -79,7 +28,7 @@ namespace day8 {
     assert(sum_metadata(test1) == 138);
 
     tree_node_t input;
-    read_day8_data(input, "data/day8/problem1/input.txt");
+    read_day8_data(input, input::resolve_path(8, "data/day8/problem1/input.txt"));
     std::cout << "Result : " << sum_metadata(input) << std::endl;
 
 #endif
@@ -94,7 +43,7 @@ namespace day8 {
     assert(test1.compute_value() == 66);
 
     tree_node_t input;
-    read_day8_data(input, "data/day8/problem2/input.txt");
+    read_day8_data(input, input::resolve_path(8, "data/day8/problem2/input.txt"));
     std::cout << "Result : " << input.compute_value() << std::endl;
 
 #endif
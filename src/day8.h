@@ -0,0 +1,78 @@
+#ifndef ADVENT_OF_CODE_2018_DAY8_H
+#define ADVENT_OF_CODE_2018_DAY8_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <fstream>
+#include <set>
+#include "scanner.h"
+
+namespace day8 {
+
+  struct tree_node_t {
+    std::vector<tree_node_t> children;
+    std::vector<int> metadata;
+
+    void parse(scanner::scanner_t &scan) {
+      int num_children, num_metadata;
+      if (!(scan.number(num_children) && scan.number(num_metadata))) {
+        throw new std::invalid_argument("Cannot parse node header!");
+      }
+      for (int i = 0; i < num_children; i++) {
+        tree_node_t child;
+        child.parse(scan);
+        children.push_back(child);
+      }
+      for (int i = 0; i < num_metadata; i++) {
+        int metadata_value;
+        if (!scan.number(metadata_value)) {
+          throw new std::invalid_argument("Cannot parse metadata!");
+        }
+        metadata.push_back(metadata_value);
+      }
+    }
+
+    void visit(std::function<void(const tree_node_t &)> visitor) const {
+      visitor(*this);
+      for (auto &child : children) {
+        child.visit(visitor);
+      }
+    }
+
+    int compute_value() {
+      if (children.empty()) {
+        int sum = 0;
+        for (auto &mval : metadata) {
+          sum += mval;
+        }
+        return sum;
+      } else {
+        // Sum of the values of the children specified by the metadata (child indices)
+        // If child index is out of bounds, skip
+        int sum = 0;
+        for (auto &cidx : metadata) {
+          if (cidx < 1 || cidx > children.size()) {
+            continue;
+          } else {
+            sum += children[cidx - 1].compute_value();
+          }
+        }
+        return sum;
+      }
+    }
+  };
+
+  void read_day8_data(tree_node_t &outdata, const char *filepath);
+
+  int sum_metadata(const tree_node_t &root);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY8_H
@@ -1,65 +1,8 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <fstream>
-#include <set>
-#include <list>
+#include "day9.h"
 
 namespace day9 {
 
-  struct game_t {
-    std::list<long> circle;
-    std::list<long>::iterator current_marble;
-    long num_players;
-    std::vector<long> scores;
-
-    game_t(int num_players) : num_players(num_players) {
-      circle.push_back(0);
-      current_marble = circle.begin();
-      scores.resize(num_players, 0);
-    }
-
-    void move_iterator_clockwise(std::list<long>::iterator &iter) {
-      iter++;
-      if (iter == circle.end()) {
-        iter = circle.begin();
-      }
-    }
-
-    void move_iterator_counter_clockwise(std::list<long>::iterator &iter) {
-      if (iter == circle.begin()) {
-        iter = circle.end();
-      }
-      iter--;
-    }
-
-    void play_marble(int player_id, long value) {
-      if (value % 23 == 0) {
-        // Special rules
-        scores[player_id] += value;
-        auto iter = current_marble;
-        for (int i = 0; i < 7; i++) {
-          move_iterator_counter_clockwise(iter);
-        }
-        current_marble = iter;
-        move_iterator_clockwise(current_marble);
-        scores[player_id] += *iter;
-        circle.erase(iter);
-      } else {
-        auto iter = current_marble;
-        move_iterator_clockwise(iter); // x2
-        move_iterator_clockwise(iter);
-        current_marble = circle.insert(iter, value);
-        // No score change
-      }
-    }
-
-    long get_highest_score() {
-      return *std::max_element(scores.begin(), scores.end());
-    }
-  };
-
-  long compute_high_score(int num_players, int last_marble_value) {
+  long compute_high_score_with_list(int num_players, int last_marble_value) {
     game_t game(num_players);
 
     int next_player_id = 0;
@@ -81,6 +24,24 @@ namespace day9 {
     return game.get_highest_score();
   }
 
+  long compute_high_score(int num_players, uint32_t last_marble_value) {
+    ring_game_t game(num_players, last_marble_value);
+
+    int next_player_id = 0;
+    for (uint64_t marble_value = 1; marble_value <= last_marble_value; marble_value++) {
+      game.play_marble(next_player_id, static_cast<uint32_t>(marble_value));
+
+      // Move to next player
+      next_player_id++;
+      if (next_player_id >= num_players) {
+        next_player_id = 0;
+      }
+    }
+
+    // Return winning score
+    return game.get_highest_score();
+  }
+
   void problem1() {
     std::cout << "Day 9 - Problem 1" << std::endl;
 #if !defined(ONLY_ACTIVATE) || ONLY_ACTIVATE == 9
@@ -91,6 +52,18 @@ namespace day9 {
     assert(compute_high_score(17, 1104) == 2764);
     assert(compute_high_score(21, 6111) == 54718);
     assert(compute_high_score(30, 5807) == 37305);
+    assert(compute_high_score_with_list(30, 5807) == 37305);
+    assert(compute_high_score_with_list(464, 70918) == compute_high_score(464, 70918));
+    {
+      // Scoring sums in 64 bits: after marbles 1-22 of the example, a 23-multiple above 2^31 still removes marble 9
+      ring_game_t game(9, 22);
+      for (uint32_t value = 1; value <= 22; value++) {
+        game.play_marble(value % 9, value);
+      }
+      uint32_t big_value = 23u * 100000000u;
+      game.play_marble(0, big_value);
+      assert(big_value > (1u << 31) && game.scores[0] == static_cast<int64_t>(big_value) + int64_t(9));
+    }
 
     std::cout << "Result : " << compute_high_score(464, 70918) << std::endl;
 
@@ -0,0 +1,127 @@
+#ifndef ADVENT_OF_CODE_2018_DAY9_H
+#define ADVENT_OF_CODE_2018_DAY9_H
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <list>
+#include <cstdint>
+#include "instrument.h"
+
+namespace day9 {
+
+  inline instrument::counter_t marbles_played{"day9.marbles_played"};
+
+  struct game_t {
+    std::list<long> circle;
+    std::list<long>::iterator current_marble;
+    long num_players;
+    std::vector<long> scores;
+
+    game_t(int num_players) : num_players(num_players) {
+      circle.push_back(0);
+      current_marble = circle.begin();
+      scores.resize(num_players, 0);
+    }
+
+    void move_iterator_clockwise(std::list<long>::iterator &iter) {
+      iter++;
+      if (iter == circle.end()) {
+        iter = circle.begin();
+      }
+    }
+
+    void move_iterator_counter_clockwise(std::list<long>::iterator &iter) {
+      if (iter == circle.begin()) {
+        iter = circle.end();
+      }
+      iter--;
+    }
+
+    void play_marble(int player_id, long value) {
+      marbles_played.add();
+      if (value % 23 == 0) {
+        // Special rules
+        scores[player_id] += value;
+        auto iter = current_marble;
+        for (int i = 0; i < 7; i++) {
+          move_iterator_counter_clockwise(iter);
+        }
+        current_marble = iter;
+        move_iterator_clockwise(current_marble);
+        scores[player_id] += *iter;
+        circle.erase(iter);
+      } else {
+        auto iter = current_marble;
+        move_iterator_clockwise(iter); // x2
+        move_iterator_clockwise(iter);
+        current_marble = circle.insert(iter, value);
+        // No score change
+      }
+    }
+
+    long get_highest_score() {
+      return *std::max_element(scores.begin(), scores.end());
+    }
+  };
+
+  // Same game as game_t with the circle kept as a doubly linked list inside two preallocated arrays indexed by marble
+  // value. Placing and removing marbles never allocates, and 32-bit links keep it at 8 bytes per marble, so games
+  // with up to ~4 billion marbles fit in memory known up front.
+  struct ring_game_t {
+    std::vector<uint32_t> next, prev;
+    uint32_t current_marble = 0;
+    std::vector<long> scores;
+
+    ring_game_t(int num_players, uint32_t last_marble_value) {
+      next.resize(static_cast<size_t>(last_marble_value) + 1);
+      prev.resize(static_cast<size_t>(last_marble_value) + 1);
+      next[0] = prev[0] = 0;
+      scores.resize(num_players, 0);
+    }
+
+    void play_marble(int player_id, uint32_t value) {
+      marbles_played.add();
+      if (value % 23 == 0) {
+        // Special rules
+        auto removed = current_marble;
+        for (int i = 0; i < 7; i++) {
+          removed = prev[removed];
+        }
+        scores[player_id] += static_cast<long>(value) + removed;
+        next[prev[removed]] = next[removed];
+        prev[next[removed]] = prev[removed];
+        current_marble = next[removed];
+      } else {
+        // Insert between the marbles 1 and 2 clockwise of the current one
+        auto left = next[current_marble];
+        auto right = next[left];
+        next[left] = value;
+        prev[value] = left;
+        next[value] = right;
+        prev[right] = value;
+        current_marble = value;
+        // No score change
+      }
+    }
+
+    long get_highest_score() {
+      return *std::max_element(scores.begin(), scores.end());
+    }
+  };
+
+  // Plays the game on game_t (std::list circle); kept as the reference for ring_game_t
+  long compute_high_score_with_list(int num_players, int last_marble_value);
+
+  long compute_high_score(int num_players, uint32_t last_marble_value);
+
+  void problem1();
+
+  void problem2();
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DAY9_H
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include "device.h"
+
+namespace device {
+
+  // What the decoded interpreter runs for each opcode. Immediate and register variants of an opcode share the
+  // operation once their operands are resolved.
+  enum operation_e {
+    op_add = 0,
+    op_mul,
+    op_and,
+    op_or,
+    op_set,
+    op_gt,
+    op_eq,
+
+    num_operations,
+  };
+
+  struct operation_format_t {
+    operation_e operation;
+    bool register_a;
+    bool register_b;
+  };
+
+  const operation_format_t operation_formats[opcode_e::num_op_codes] = {
+    {op_add, true,  true},   // addr
+    {op_add, true,  false},  // addi
+    {op_mul, true,  true},   // mulr
+    {op_mul, true,  false},  // muli
+    {op_and, true,  true},   // banr
+    {op_and, true,  false},  // bani
+    {op_or,  true,  true},   // borr
+    {op_or,  true,  false},  // bori
+    {op_set, true,  false},  // setr
+    {op_set, false, false},  // seti
+    {op_gt,  false, true},   // gtir
+    {op_gt,  true,  false},  // gtri
+    {op_gt,  true,  true},   // gtrr
+    {op_eq,  false, true},   // eqir
+    {op_eq,  true,  false},  // eqri
+    {op_eq,  true,  true},   // eqrr
+  };
+
+  // Handlers come in pairs, the second one for instructions that write the instruction pointer register. Then the
+  // handler of jumps whose target is known when decoding, and the one that ends the program.
+  int handler_index(operation_e operation, bool jump) {
+    return operation * 2 + (jump ? 1 : 0);
+  }
+
+  const int branch_handler_index = num_operations * 2;
+  const int halt_handler_index = branch_handler_index + 1;
+
+  // Steps through the source instructions with execute(). Used when tracing, and as the portable interpreter.
+  long run_reference(device_t &device, const program_t &program, long limit) {
+    auto &state = device.state;
+    auto &instruction_pointer = device.instruction_pointer;
+    const int num_instructions = static_cast<int>(program.instructions.size());
+    long count = 0;
+    if (device.trace) *device.trace << count << ", " << limit << std::endl;
+    while (instruction_pointer >= 0 && instruction_pointer < num_instructions && count < limit) {
+      if (device.trace) {
+        *device.trace << std::setw(16) << count << " ip: " << std::setw(4) << instruction_pointer << " | "
+                      << std::setw(20) << state << "\t -> ";
+      }
+      int executed_ip = instruction_pointer;
+      auto &instruction_to_run = program.instructions[instruction_pointer];
+      if (program.ip_reg != -1) state.registers[program.ip_reg] = instruction_pointer;
+      execute(instruction_to_run.opcode, instruction_to_run.inputA, instruction_to_run.inputB,
+              instruction_to_run.outputC, state.registers);
+      if (device.trace) {
+        *device.trace << std::setw(16) << instruction_to_run << "\t -> " << std::setw(16) << state << std::endl;
+      }
+      if (program.ip_reg != -1) instruction_pointer = state.registers[program.ip_reg];
+      instruction_pointer++;
+      count++;
+
+      if (executed_ip == device.break_on_ip) {
+        if (device.trace) *device.trace << "Breakpoint reached" << std::endl;
+        break;
+      }
+    }
+    return count;
+  }
+
+#if defined(__GNUC__)
+
+  // Threaded interpreter: each handler ends by jumping straight to the handler of the next instruction instead of
+  // going back through a switch. Handler addresses (GCC labels as values) only exist inside this function, so called
+  // without a program it just returns them for decode(). Operands index file; ip is updated to the next instruction
+  // to run and count to the number of instructions run. Nothing reads the bound register from file, so jumps do not
+  // write it.
+#if !defined(__clang__)
+  __attribute__((optimize("no-crossjumping", "no-gcse")))
+#endif
+  const void *const *run_threaded(const decoded_program_t *program, long *file, long &ip, long limit, long break_on_ip,
+                                  long &count) {
+    static const void *const handlers[] = {
+      &&add, &&add_jump,
+      &&mul, &&mul_jump,
+      &&bit_and, &&bit_and_jump,
+      &&bit_or, &&bit_or_jump,
+      &&set, &&set_jump,
+      &&gt, &&gt_jump,
+      &&eq, &&eq_jump,
+      &&branch,
+      &&halt,
+    };
+    static_assert(sizeof(handlers) / sizeof(handlers[0]) == halt_handler_index + 1);
+    if (!program) return handlers;
+
+    const decoded_instruction_t *code = program->code.data();
+    const unsigned long size = program->source.instructions.size();
+    const decoded_instruction_t *in;
+    long pc = ip;
+    long n = 0;
+    if ((unsigned long) pc >= size || limit <= 0) return handlers;
+    in = &code[pc];
+    goto *in->handler;
+
+    // The halt instruction past the end catches falling off the program. Jumps check their target.
+#define NEXT_INSTRUCTION \
+    n++; \
+    if (pc == break_on_ip || n == limit) { pc++; goto done; } \
+    in = &code[++pc]; \
+    goto *in->handler
+#define BRANCH_TO(target) \
+    n++; \
+    if (pc == break_on_ip || n == limit) { pc = (target); goto done; } \
+    pc = (target); \
+    if ((unsigned long) pc >= size) goto done; \
+    in = &code[pc]; \
+    goto *in->handler
+#define JUMP(value) BRANCH_TO((value) + 1)
+
+    add:          file[in->c] = file[in->a] + file[in->b];    NEXT_INSTRUCTION;
+    add_jump:     JUMP(file[in->a] + file[in->b]);
+    mul:          file[in->c] = file[in->a] * file[in->b];    NEXT_INSTRUCTION;
+    mul_jump:     JUMP(file[in->a] * file[in->b]);
+    bit_and:      file[in->c] = file[in->a] & file[in->b];    NEXT_INSTRUCTION;
+    bit_and_jump: JUMP(file[in->a] & file[in->b]);
+    bit_or:       file[in->c] = file[in->a] | file[in->b];    NEXT_INSTRUCTION;
+    bit_or_jump:  JUMP(file[in->a] | file[in->b]);
+    set:          file[in->c] = file[in->a];                  NEXT_INSTRUCTION;
+    set_jump:     JUMP(file[in->a]);
+    gt:           file[in->c] = file[in->a] > file[in->b];    NEXT_INSTRUCTION;
+    gt_jump:      JUMP(file[in->a] > file[in->b]);
+    eq:           file[in->c] = file[in->a] == file[in->b];   NEXT_INSTRUCTION;
+    eq_jump:      JUMP(file[in->a] == file[in->b]);
+    branch:       BRANCH_TO(in->a);
+    halt:         goto done;
+
+#undef JUMP
+#undef BRANCH_TO
+#undef NEXT_INSTRUCTION
+
+    done:
+    ip = pc;
+    count = n;
+    return handlers;
+  }
+
+  long run_decoded(device_t &device, const decoded_program_t &program, long limit) {
+    // Operand file: the registers, then the constants
+    thread_local std::vector<long> file;
+    file.assign(device.state.registers.begin(), device.state.registers.end());
+    file.insert(file.end(), program.constants.begin(), program.constants.end());
+
+    long ip = device.instruction_pointer;
+    long count = 0;
+    run_threaded(&program, file.data(), ip, limit, device.break_on_ip, count);
+
+    std::copy(file.begin(), file.begin() + num_registers, device.state.registers.begin());
+    // Reads of the bound register were resolved to constants, so it is only brought up to date here: it holds the
+    // instruction pointer the last instruction left behind.
+    if (count > 0 && program.source.ip_reg != -1) device.state.registers[program.source.ip_reg] = ip - 1;
+    device.instruction_pointer = ip;
+    return count;
+  }
+
+#endif
+
+  decoded_program_t decode(const program_t &program) {
+    decoded_program_t decoded;
+    decoded.source = program;
+    int ip_reg = program.ip_reg;
+    if (ip_reg < -1 || ip_reg >= num_registers) throw new std::invalid_argument("Instruction pointer out of range!");
+
+    auto constant = [&](long value) {
+      decoded.constants.push_back(value);
+      return static_cast<int>(num_registers + decoded.constants.size() - 1);
+    };
+    auto register_operand = [&](long reg, int ip) {
+      if (reg < 0 || reg >= num_registers) throw new std::invalid_argument("Register out of range!");
+      // The bound register always holds the index of the instruction reading it
+      return reg == ip_reg ? constant(ip) : static_cast<int>(reg);
+    };
+
+#if defined(__GNUC__)
+    long unused = 0;
+    const void *const *handlers = run_threaded(nullptr, nullptr, unused, 0, 0, unused);
+#endif
+    const int num_instructions = static_cast<int>(program.instructions.size());
+    for (int ip = 0; ip < num_instructions; ip++) {
+      auto &instruction = program.instructions[ip];
+      if (instruction.opcode < 0 || instruction.opcode >= opcode_e::num_op_codes) {
+        throw new std::invalid_argument("Unknown opcode!");
+      }
+      if (instruction.outputC < 0 || instruction.outputC >= num_registers) {
+        throw new std::invalid_argument("Register out of range!");
+      }
+      auto &format = operation_formats[instruction.opcode];
+      decoded_instruction_t decoded_instruction;
+      bool jump = instruction.outputC == ip_reg;
+      bool constant_a = !format.register_a || instruction.inputA == ip_reg;
+      bool constant_b = !format.register_b || instruction.inputB == ip_reg || format.operation == op_set;
+      if (jump && constant_a && constant_b) {
+        // Jump to a fixed instruction (e.g. "seti 7 0 ip" or "addi ip 1 ip"): resolve its target now
+        std::array<long, num_registers> registers{0};
+        registers[ip_reg] = ip;
+        execute(instruction.opcode, instruction.inputA, instruction.inputB, instruction.outputC, registers);
+        decoded_instruction.a = static_cast<int>(registers[ip_reg] + 1);
+        decoded_instruction.c = static_cast<int>(instruction.outputC);
+#if defined(__GNUC__)
+        decoded_instruction.handler = handlers[branch_handler_index];
+#endif
+        decoded.code.push_back(decoded_instruction);
+        continue;
+      }
+
+      decoded_instruction.a = format.register_a ? register_operand(instruction.inputA, ip)
+                                                : constant(instruction.inputA);
+      if (format.operation == op_set) {
+        // Input B is ignored
+        decoded_instruction.b = decoded_instruction.a;
+      } else {
+        decoded_instruction.b = format.register_b ? register_operand(instruction.inputB, ip)
+                                                  : constant(instruction.inputB);
+      }
+      decoded_instruction.c = static_cast<int>(instruction.outputC);
+#if defined(__GNUC__)
+      decoded_instruction.handler = handlers[handler_index(format.operation, jump)];
+#endif
+      decoded.code.push_back(decoded_instruction);
+    }
+
+    decoded_instruction_t halt;
+#if defined(__GNUC__)
+    halt.handler = handlers[halt_handler_index];
+#endif
+    decoded.code.push_back(halt);
+    return decoded;
+  }
+
+  void device_t::run(const decoded_program_t &program, long limit, bool reset_ip) {
+    if (reset_ip) instruction_pointer = 0;
+#if defined(__GNUC__)
+    long count = trace ? run_reference(*this, program.source, limit) : run_decoded(*this, program, limit);
+#else
+    long count = run_reference(*this, program.source, limit);
+#endif
+    instruction_count += count;
+    instructions_executed.add(count);
+  }
+
+}
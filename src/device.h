@@ -0,0 +1,270 @@
+#ifndef ADVENT_OF_CODE_2018_DEVICE_H
+#define ADVENT_OF_CODE_2018_DEVICE_H
+
+#include <cassert>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <limits>
+#include <array>
+#include <string>
+#include <stdexcept>
+#include "instrument.h"
+
+// The wrist device of days 16, 19 and 21: six registers, sixteen opcodes and an optional instruction pointer register
+namespace device {
+
+  const bool trace_read = false;
+
+  inline instrument::counter_t instructions_executed{"device.instructions"};
+
+  enum opcode_e {
+    addr = 0,
+    addi,
+    mulr,
+    muli,
+    banr,
+    bani,
+    borr,
+    bori,
+    setr,
+    seti,
+    gtir,
+    gtri,
+    gtrr,
+    eqir,
+    eqri,
+    eqrr,
+
+    num_op_codes,
+  };
+
+  const std::string opcode_str[] = {
+    "addr",
+    "addi",
+    "mulr",
+    "muli",
+    "banr",
+    "bani",
+    "borr",
+    "bori",
+    "setr",
+    "seti",
+    "gtir",
+    "gtri",
+    "gtrr",
+    "eqir",
+    "eqri",
+    "eqrr"
+  };
+
+  const int num_registers = 6;
+
+  // Executes one instruction on r, which can be any array of registers (day 16 samples only have 4). Reference for the
+  // decoded interpreter.
+  template<typename registers_t, typename operand_t>
+  void execute(int opcode, operand_t A, operand_t B, operand_t C, registers_t &r) {
+    switch (opcode) {
+      case addr: {
+        // (add register) stores into register C the result of adding register A and register B.
+        r[C] = r[A] + r[B];
+        break;
+      }
+      case addi: {
+        // (add immediate) stores into register C the result of adding register A and value B.
+        r[C] = r[A] + B;
+        break;
+      }
+      case mulr: {
+        // (multiply register) stores into register C the result of multiplying register A and register B.
+        r[C] = r[A] * r[B];
+        break;
+      }
+      case muli: {
+        // (multiply immediate) stores into register C the result of multiplying register A and value B.
+        r[C] = r[A] * B;
+        break;
+      }
+      case banr: {
+        // (bitwise AND register) stores into register C the result of the bitwise AND of register A and register B.
+        r[C] = r[A] & r[B];
+        break;
+      }
+      case bani: {
+        // (bitwise AND immediate) stores into register C the result of the bitwise AND of register A and value B.
+        r[C] = r[A] & B;
+        break;
+      }
+      case borr: {
+        // (bitwise OR register) stores into register C the result of the bitwise OR of register A and register B.
+        r[C] = r[A] | r[B];
+        break;
+      }
+      case bori: {
+        // (bitwise OR immediate) stores into register C the result of the bitwise OR of register A and value B.
+        r[C] = r[A] | B;
+        break;
+      }
+      case setr: {
+        // (set register) copies the contents of register A into register C. (Input B is ignored.)
+        r[C] = r[A];
+        break;
+      }
+      case seti: {
+        // (set immediate) stores value A into register C. (Input B is ignored.)
+        r[C] = A;
+        break;
+      }
+      case gtir: {
+        // (greater-than immediate/register) sets register C to 1 if value A is greater than register B. Otherwise, register C is set to 0.
+        r[C] = (A > r[B]) ? 1 : 0;
+        break;
+      }
+      case gtri: {
+        // (greater-than register/immediate) sets register C to 1 if register A is greater than value B. Otherwise, register C is set to 0.
+        r[C] = (r[A] > B) ? 1 : 0;
+        break;
+      }
+      case gtrr: {
+        // (greater-than register/register) sets register C to 1 if register A is greater than register B. Otherwise, register C is set to 0.
+        r[C] = (r[A] > r[B]) ? 1 : 0;
+        break;
+      }
+      case eqir: {
+        // (equal immediate/register) sets register C to 1 if value A is equal to register B. Otherwise, register C is set to 0.
+        r[C] = (A == r[B]) ? 1 : 0;
+        break;
+      }
+      case eqri: {
+        // (equal register/immediate) sets register C to 1 if register A is equal to value B. Otherwise, register C is set to 0.
+        r[C] = (r[A] == B) ? 1 : 0;
+        break;
+      }
+      case eqrr: {
+        // (equal register/register) sets register C to 1 if register A is equal to register B. Otherwise, register C is set to 0.
+        r[C] = (r[A] == r[B]) ? 1 : 0;
+        break;
+      }
+      default: {
+        assert("Unknown opcode!");
+      }
+    }
+  }
+
+  struct instruction_t {
+    int opcode;
+    long inputA;
+    long inputB;
+    long outputC;
+
+    friend std::istream &operator>>(std::istream &in, instruction_t &instr) {
+      std::string opstr;
+      if (!(in >> opstr >> instr.inputA >> instr.inputB >> instr.outputC)) return in;
+      instr.opcode = -1;
+      for (int i = 0; i < opcode_e::num_op_codes; i++) {
+        if (opstr == opcode_str[i]) {
+          instr.opcode = i;
+          break;
+        }
+      }
+      if (instr.opcode == -1) throw new std::invalid_argument("Unknown opcode!");
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const instruction_t &instr) {
+      out << opcode_str[instr.opcode] << " " << instr.inputA << " " << instr.inputB << " " << instr.outputC;
+      return out;
+    }
+  };
+
+  struct program_t {
+    std::vector<instruction_t> instructions;
+    int ip_reg = -1;  // -1 when the instruction pointer is not bound to a register
+
+    friend std::istream &operator>>(std::istream &in, program_t &program) {
+      instruction_t instruction;
+      std::string str;
+      in >> str >> program.ip_reg;
+      if (trace_read) std::cout << "#ip " << program.ip_reg << std::endl;
+      getline(in, str);
+      // Stops at the end of the input, trailing newline included
+      while (in >> instruction) {
+        program.instructions.push_back(instruction);
+        if (trace_read) std::cout << instruction << std::endl;
+      }
+      return in;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const program_t &program) {
+      out << "#ip " << program.ip_reg << std::endl;
+      for (auto &instruction : program.instructions) {
+        out << instruction << std::endl;
+      }
+      return out;
+    }
+  };
+
+  struct device_state_t {
+    std::array<long, num_registers> registers{0};
+
+    void clear() { registers = std::array<long, num_registers>{0}; }
+
+    bool operator==(const device_state_t &other) const {
+      return registers == other.registers;
+    }
+
+    friend std::ostream &operator<<(std::ostream &out, const device_state_t &ds) {
+      out << "[" << ds.registers[0] << ", " << ds.registers[1] << ", " << ds.registers[2] << ", " << ds.registers[3]
+          << ", " << ds.registers[4] << ", " << ds.registers[5] << "]";
+      return out;
+    }
+  };
+
+  // Operands index an operand file: the registers, then the constants of the program. Immediates become constants, and
+  // so do reads of the instruction pointer register, which always hold the index of the instruction being executed.
+  // handler is the interpreter's code for the operation, with a separate variant for instructions that write the
+  // instruction pointer register and so jump.
+  struct decoded_instruction_t {
+    const void *handler = nullptr;
+    int a = 0;
+    int b = 0;
+    int c = 0;
+  };
+
+  struct decoded_program_t {
+    program_t source;
+    std::vector<decoded_instruction_t> code;  // One past the source instructions: a halt instruction
+    std::vector<long> constants;
+  };
+
+  // Resolves every operand and handler once, so the interpreter does no decoding per step. Throws if an opcode or a
+  // register operand is out of range.
+  decoded_program_t decode(const program_t &program);
+
+  struct device_t {
+    device_state_t state;
+    int instruction_pointer = 0;
+    long instruction_count = 0;
+    int break_on_ip = -1;           // Stop right after executing the instruction at this index
+    std::ostream *trace = nullptr;  // Print every instruction executed here (slow)
+
+    // Runs from instruction_pointer (0 when reset_ip) until it leaves the program, limit instructions have run or the
+    // breakpoint is hit. When the instruction pointer is bound to a register, its value is written to that register
+    // just before each instruction is executed, and the value of that register is written back to the instruction
+    // pointer immediately after each instruction finishes execution.
+    void run(const decoded_program_t &program, long limit = std::numeric_limits<long>::max(), bool reset_ip = true);
+
+    void run(const program_t &program, long limit = std::numeric_limits<long>::max(), bool reset_ip = true) {
+      run(decode(program), limit, reset_ip);
+    }
+
+    // Executes instruction without touching the instruction pointer
+    void process(const instruction_t &instruction) {
+      instructions_executed.add();
+      execute(instruction.opcode, instruction.inputA, instruction.inputB, instruction.outputC, state.registers);
+    }
+  };
+
+}
+
+#endif //ADVENT_OF_CODE_2018_DEVICE_H
@@ -0,0 +1,59 @@
+#include <random>
+#include <string>
+#include "generate.h"
+#include "day3.h"
+
+namespace generate {
+
+  // Day 3: "#id @ x,y: wxh" claims. Claims stay inside the solver's fixed-size fabric.
+  void write_day3_input(std::ostream &out, long num_claims, std::mt19937 &rng) {
+    std::uniform_int_distribution<int> side(1, 30);
+    for (long id = 1; id <= num_claims; id++) {
+      int width = side(rng), height = side(rng);
+      int x = std::uniform_int_distribution<int>(1, day3::FABRIC_MAX_DIM - width)(rng);
+      int y = std::uniform_int_distribution<int>(1, day3::FABRIC_MAX_DIM - height)(rng);
+      out << "#" << id << " @ " << x << "," << y << ": " << width << "x" << height;
+      if (id < num_claims) out << '\n';
+    }
+  }
+
+  // Day 18: square map of open ground '.', trees '|' and lumberyards '#' in roughly the puzzle's proportions
+  void write_day18_input(std::ostream &out, long dim, std::mt19937 &rng) {
+    std::discrete_distribution<int> acre({50, 30, 20});
+    const char acre_chars[] = {'.', '|', '#'};
+    std::string row(dim, '.');
+    for (long y = 0; y < dim; y++) {
+      for (auto &c : row) {
+        c = acre_chars[acre(rng)];
+      }
+      out << row;
+      if (y < dim - 1) out << '\n';
+    }
+  }
+
+  // Day 23: "pos=<x,y,z>, r=radius" nanobots spread like the puzzle's
+  void write_day23_input(std::ostream &out, long num_nanobots, std::mt19937 &rng) {
+    std::uniform_int_distribution<long> coord(-150000000, 150000000);
+    std::uniform_int_distribution<long> radius(50000000, 100000000);
+    for (long i = 0; i < num_nanobots; i++) {
+      out << "pos=<" << coord(rng) << "," << coord(rng) << "," << coord(rng) << ">, r=" << radius(rng);
+      if (i < num_nanobots - 1) out << '\n';
+    }
+  }
+
+  bool is_supported(int day) {
+    return day == 3 || day == 18 || day == 23;
+  }
+
+  bool write_input(std::ostream &out, int day, const options_t &options) {
+    std::mt19937 rng(options.seed);
+    switch (day) {
+      case 3:   write_day3_input(out, options.size > 0 ? options.size : 1000000, rng);   break;
+      case 18:  write_day18_input(out, options.size > 0 ? options.size : 5000, rng);     break;
+      case 23:  write_day23_input(out, options.size > 0 ? options.size : 100000, rng);   break;
+      default:  return false;
+    }
+    return true;
+  }
+
+}
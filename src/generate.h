@@ -0,0 +1,23 @@
+#ifndef ADVENT_OF_CODE_2018_GENERATE_H
+#define ADVENT_OF_CODE_2018_GENERATE_H
+
+#include <iostream>
+
+namespace generate {
+
+  struct options_t {
+    // Number of records (claims, nanobots) or side length of the map. 0 picks the day's default scale.
+    long size = 0;
+    unsigned seed = 2018;
+  };
+
+  // Days with a synthetic input generator
+  bool is_supported(int day);
+
+  // Writes a random puzzle input for day in the same format as data/dayN/*/input.txt. Sizes are well past the puzzle
+  // inputs so the solvers can be measured at scale. Returns false if day has no generator.
+  bool write_input(std::ostream &out, int day, const options_t &options);
+
+}
+
+#endif //ADVENT_OF_CODE_2018_GENERATE_H
@@ -0,0 +1,135 @@
+#ifndef ADVENT_OF_CODE_2018_GRID2D_H
+#define ADVENT_OF_CODE_2018_GRID2D_H
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace grid2d {
+
+  // Offsets of the 4 orthogonal neighbours in reading order (up, left, right, down)
+  const int orthogonal_dx[4] = {0, -1, 1, 0};
+  const int orthogonal_dy[4] = {-1, 0, 0, 1};
+
+  // Offsets of the 8 surrounding neighbours in reading order
+  const int surrounding_dx[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+  const int surrounding_dy[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+  // width x height grid stored contiguously in row-major order, surrounded by a border of padding cells on every
+  // side. Coordinates run from -padding to width + padding - 1 (height likewise), so the neighbours of any cell
+  // inside the grid can be read without bounds checks as long as padding >= 1. Border cells start out as fill and
+  // are otherwise treated like any other cell.
+  template<typename T>
+  struct grid2d_t {
+    int width = 0, height = 0;
+    int padding = 0;
+    int stride = 0;   // Cells per stored row, border included
+    std::vector<T> cells;
+
+    grid2d_t() {}
+
+    grid2d_t(int _width, int _height, int _padding = 0, const T &fill = T()) {
+      resize(_width, _height, _padding, fill);
+    }
+
+    void resize(int _width, int _height, int _padding = 0, const T &fill = T()) {
+      width = _width;
+      height = _height;
+      padding = _padding;
+      stride = width + 2 * padding;
+      cells.assign(static_cast<size_t>(stride) * (height + 2 * padding), fill);
+    }
+
+    bool contains(int x, int y) const {
+      return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    bool contains_padded(int x, int y) const {
+      return x >= -padding && x < width + padding && y >= -padding && y < height + padding;
+    }
+
+    // Flat position of (x, y) in cells
+    int index_of(int x, int y) const {
+      assert(contains_padded(x, y));
+      return (y + padding) * stride + x + padding;
+    }
+
+    int x_of(int index) const {
+      return index % stride - padding;
+    }
+
+    int y_of(int index) const {
+      return index / stride - padding;
+    }
+
+    // Distance in cells between (x, y) and (x + dx, y + dy)
+    int offset_of(int dx, int dy) const {
+      return dy * stride + dx;
+    }
+
+    T &at(int x, int y) {
+      return cells[index_of(x, y)];
+    }
+
+    const T &at(int x, int y) const {
+      return cells[index_of(x, y)];
+    }
+
+    // Cell x = 0 of row y; valid from row[-padding] to row[width + padding - 1]
+    T *row(int y) {
+      return &cells[index_of(0, y)];
+    }
+
+    const T *row(int y) const {
+      return &cells[index_of(0, y)];
+    }
+
+    void fill(const T &value) {
+      std::fill(cells.begin(), cells.end(), value);
+    }
+
+    // Calls visitor(x, y, cell) for every cell inside the grid, in reading order
+    template<typename visitor_t>
+    void for_each(visitor_t visitor) {
+      for (int y = 0; y < height; y++) {
+        T *cells_row = row(y);
+        for (int x = 0; x < width; x++) {
+          visitor(x, y, cells_row[x]);
+        }
+      }
+    }
+
+    template<typename visitor_t>
+    void for_each(visitor_t visitor) const {
+      for (int y = 0; y < height; y++) {
+        const T *cells_row = row(y);
+        for (int x = 0; x < width; x++) {
+          visitor(x, y, cells_row[x]);
+        }
+      }
+    }
+
+    // Calls visitor(nx, ny, cell) for the orthogonal neighbours of (x, y) in reading order. Neighbours outside the
+    // padded grid are skipped.
+    template<typename visitor_t>
+    void for_each_orthogonal(int x, int y, visitor_t visitor) {
+      for (int i = 0; i < 4; i++) {
+        int nx = x + orthogonal_dx[i], ny = y + orthogonal_dy[i];
+        if (contains_padded(nx, ny)) visitor(nx, ny, at(nx, ny));
+      }
+    }
+
+    // Calls visitor(nx, ny, cell) for the 8 surrounding neighbours of (x, y) in reading order. Neighbours outside
+    // the padded grid are skipped.
+    template<typename visitor_t>
+    void for_each_surrounding(int x, int y, visitor_t visitor) {
+      for (int i = 0; i < 8; i++) {
+        int nx = x + surrounding_dx[i], ny = y + surrounding_dy[i];
+        if (contains_padded(nx, ny)) visitor(nx, ny, at(nx, ny));
+      }
+    }
+  };
+
+}
+
+#endif //ADVENT_OF_CODE_2018_GRID2D_H
@@ -0,0 +1,76 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include "input.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace input {
+
+  // Only written while parsing the command line, before any problem runs
+  std::map<std::string, std::string> path_overrides;
+
+  void set_path_override(const std::string &key, const std::string &path) {
+    path_overrides[key] = path;
+  }
+
+  const char *resolve_path(int day, const char *default_path) {
+    if (path_overrides.empty()) return default_path;
+    std::string name = default_path;
+    name = name.substr(name.find_last_of('/') + 1);
+    name = name.substr(0, name.rfind(".txt"));
+    if (name.compare(0, 6, "input_") == 0) {
+      auto it = path_overrides.find(std::to_string(day) + ":" + name.substr(6));
+      if (it != path_overrides.end()) return it->second.c_str();
+    }
+    auto it = path_overrides.find(std::to_string(day));
+    if (it != path_overrides.end()) return it->second.c_str();
+    return default_path;
+  }
+
+  mapped_file_t::mapped_file_t(const char *filepath) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = open(filepath, O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Cannot open file " << filepath << "!" << std::endl;
+      return;
+    }
+    struct stat info{};
+    bool regular_file = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+    if (regular_file && info.st_size > 0) {
+      void *address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED) {
+        // Inputs are parsed front to back exactly once
+        madvise(address, info.st_size, MADV_SEQUENTIAL);
+        data = static_cast<const char *>(address);
+        size = info.st_size;
+        mapped = true;
+      }
+    }
+    close(fd);
+    // Pipes, devices and /proc files report no size and are read as streams
+    if (mapped || (regular_file && info.st_size == 0)) return;
+#endif
+    std::ifstream input_stream(filepath, std::ios::binary);
+    if (!input_stream.is_open()) {
+      std::cerr << "Cannot open file " << filepath << "!" << std::endl;
+      return;
+    }
+    fallback.assign(std::istreambuf_iterator<char>(input_stream), std::istreambuf_iterator<char>());
+    data = fallback.data();
+    size = fallback.size();
+  }
+
+  mapped_file_t::~mapped_file_t() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (mapped) munmap(const_cast<char *>(data), size);
+#endif
+  }
+
+}
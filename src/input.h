@@ -0,0 +1,75 @@
+#ifndef ADVENT_OF_CODE_2018_INPUT_H
+#define ADVENT_OF_CODE_2018_INPUT_H
+
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace input {
+
+  // Read-only view of a whole input file. The file is memory mapped where the platform supports it and read into
+  // memory otherwise. A file that cannot be opened reports an error and reads as empty.
+  struct mapped_file_t {
+    const char *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::string fallback;
+
+    explicit mapped_file_t(const char *filepath);
+
+    ~mapped_file_t();
+
+    mapped_file_t(const mapped_file_t &) = delete;
+
+    mapped_file_t &operator=(const mapped_file_t &) = delete;
+
+    std::string_view contents() const {
+      return std::string_view(data, size);
+    }
+  };
+
+  // Makes the day (or "day:name") named by key read its puzzle input from path for the rest of the run. Days with
+  // several input files name them after the default file, without its "input_" prefix and ".txt" extension, e.g.
+  // "16:trace" and "16:program"; a plain day number covers all of them.
+  void set_path_override(const std::string &key, const std::string &path);
+
+  // Where to read a day's puzzle input from: its override if one was set, otherwise default_path
+  const char *resolve_path(int day, const char *default_path);
+
+  // Splits the first line off text (without its line terminator) into line. Returns false once text is empty, so a
+  // trailing newline does not produce an extra empty line.
+  inline bool next_line(std::string_view &text, std::string_view &line) {
+    if (text.empty()) return false;
+    auto end = text.find('\n');
+    if (end == std::string_view::npos) {
+      line = text;
+      text = std::string_view();
+    } else {
+      line = text.substr(0, end);
+      text.remove_prefix(end + 1);
+    }
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    return true;
+  }
+
+  // Lets the parsers built on formatted extraction read straight from a mapped file without copying it into a
+  // stream buffer first
+  struct view_streambuf_t : public std::streambuf {
+    explicit view_streambuf_t(std::string_view view) {
+      auto *begin = const_cast<char *>(view.data());
+      setg(begin, begin, begin + view.size());
+    }
+  };
+
+  struct view_istream_t : public std::istream {
+    view_streambuf_t streambuf;
+
+    explicit view_istream_t(std::string_view view) : std::istream(nullptr), streambuf(view) {
+      rdbuf(&streambuf);
+    }
+  };
+
+}
+
+#endif //ADVENT_OF_CODE_2018_INPUT_H
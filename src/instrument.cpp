@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "instrument.h"
+
+namespace instrument {
+
+  bool enabled = false;
+
+  // Function-local so counters defined in other translation units can register during static initialization
+  std::vector<counter_t *> &counters() {
+    static std::vector<counter_t *> registered;
+    return registered;
+  }
+
+  std::vector<timer_stats_t *> &timers() {
+    static std::vector<timer_stats_t *> registered;
+    return registered;
+  }
+
+  counter_t::counter_t(const char *_name) : name(_name) {
+    counters().push_back(this);
+  }
+
+  timer_stats_t::timer_stats_t(const char *_name) : name(_name) {
+    timers().push_back(this);
+  }
+
+  template<typename T>
+  std::vector<T *> sorted_by_name(const std::vector<T *> &items) {
+    std::vector<T *> sorted = items;
+    std::sort(sorted.begin(), sorted.end(), [](const T *a, const T *b) {
+      return std::string(a->name) < std::string(b->name);
+    });
+    return sorted;
+  }
+
+  void write_summary(std::ostream &out) {
+    out << "Instrumentation summary" << std::endl;
+    for (auto *counter : sorted_by_name(counters())) {
+      auto count = counter->count.load();
+      if (count == 0) continue;
+      out << "  " << std::left << std::setw(40) << counter->name << std::right << std::setw(16) << count << std::endl;
+    }
+    for (auto *timer : sorted_by_name(timers())) {
+      auto calls = timer->calls.load();
+      if (calls == 0) continue;
+      auto total_us = timer->total_ns.load() / 1000;
+      out << "  " << std::left << std::setw(40) << timer->name << std::right << std::setw(16) << total_us << " us in "
+          << calls << " calls" << std::endl;
+    }
+  }
+
+}
@@ -0,0 +1,69 @@
+#ifndef ADVENT_OF_CODE_2018_INSTRUMENT_H
+#define ADVENT_OF_CODE_2018_INSTRUMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+// Solver instrumentation: each day declares its counters and timers at the top of its namespace. When run with
+// --instrument, main prints whatever they recorded to stderr at exit (write_summary).
+namespace instrument {
+
+  // Off by default. Switched on once at startup (--instrument); every recording call checks it first so disabled
+  // instrumentation costs a predictable branch.
+  extern bool enabled;
+
+  // Counts events in a solver. Define one per event at namespace scope (inline when in a header); it registers
+  // itself for the summary under name (e.g. "day13.ticks").
+  struct counter_t {
+    const char *name;
+    std::atomic<unsigned long long> count{0};
+
+    explicit counter_t(const char *_name);
+
+    void add(unsigned long long n = 1) {
+      if (enabled) count.fetch_add(n, std::memory_order_relaxed);
+    }
+  };
+
+  // Accumulated wall time and number of calls of a solver section. Recorded through scoped_timer_t.
+  struct timer_stats_t {
+    const char *name;
+    std::atomic<unsigned long long> calls{0};
+    std::atomic<unsigned long long> total_ns{0};
+
+    explicit timer_stats_t(const char *_name);
+  };
+
+  // Times the enclosing scope into stats
+  struct scoped_timer_t {
+    timer_stats_t *stats = nullptr;
+    std::chrono::steady_clock::time_point start;
+
+    explicit scoped_timer_t(timer_stats_t &_stats) {
+      if (enabled) {
+        stats = &_stats;
+        start = std::chrono::steady_clock::now();
+      }
+    }
+
+    ~scoped_timer_t() {
+      if (stats) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        stats->calls.fetch_add(1, std::memory_order_relaxed);
+        stats->total_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                  std::memory_order_relaxed);
+      }
+    }
+
+    scoped_timer_t(const scoped_timer_t &) = delete;
+
+    scoped_timer_t &operator=(const scoped_timer_t &) = delete;
+  };
+
+  // Prints every counter and timer that recorded something, sorted by name
+  void write_summary(std::ostream &out);
+
+}
+
+#endif //ADVENT_OF_CODE_2018_INSTRUMENT_H
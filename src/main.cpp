@@ -2,126 +2,89 @@
 #include <array>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <fstream>
+#include <cstdlib>
+#include "bench.h"
+#include "generate.h"
+#include "input.h"
+#include "instrument.h"
+#include "runner.h"
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+#include "day6.h"
+#include "day7.h"
+#include "day8.h"
+#include "day9.h"
+#include "day10.h"
+#include "day11.h"
+#include "day12.h"
+#include "day13.h"
+#include "day14.h"
+#include "day15.h"
+#include "day16.h"
+#include "day17.h"
+#include "day18.h"
+#include "day19.h"
+#include "day20.h"
+#include "day21.h"
+#include "day22.h"
+#include "day23.h"
+
+// generate DAY [--size N] [--seed N] [--output PATH]
+int run_generate(int argc, char const *argv[], const char *usage) {
+  int day = -1;
+  generate::options_t options;
+  std::string output_path;
+  for (int i = 2; i < argc; i++) {
+    std::string arg = argv[i];
+    try {
+      if (arg == "--size" && i + 1 < argc) {
+        options.size = std::stol(argv[++i]);
+      } else if (arg == "--seed" && i + 1 < argc) {
+        options.seed = std::stoul(argv[++i]);
+      } else if (arg == "--output" && i + 1 < argc) {
+        output_path = argv[++i];
+      } else if (day == -1 && arg[0] != '-') {
+        day = std::stoi(arg);
+      } else {
+        std::cerr << "ERROR: Unknown parameter '" << arg << "'" << std::endl << usage << std::endl;
+        return -1;
+      }
+    } catch (...) {
+      std::cerr << "ERROR: Invalid parameter!" << std::endl << usage << std::endl;
+      return -2;
+    }
+  }
+  if (!generate::is_supported(day)) {
+    std::cerr << "ERROR: No input generator for day " << day << "! Supported days: 3, 18, 23" << std::endl;
+    return -3;
+  }
+  if (options.size < 0) {
+    std::cerr << "ERROR: Size parameter is invalid!" << std::endl;
+    return -6;
+  }
 
-// Forward declarations
-namespace day1 {
-  void problem1();
-
-  void problem2();
-}
-namespace day2 {
-  void problem1();
-
-  void problem2();
-}
-namespace day3 {
-  void problem1();
-
-  void problem2();
-}
-namespace day4 {
-  void problem1();
-
-  void problem2();
-}
-namespace day5 {
-  void problem1();
-
-  void problem2();
-}
-namespace day6 {
-  void problem1();
-
-  void problem2();
-}
-namespace day7 {
-  void problem1();
-
-  void problem2();
-}
-namespace day8 {
-  void problem1();
-
-  void problem2();
-}
-namespace day9 {
-  void problem1();
-
-  void problem2();
-}
-namespace day10 {
-  void problem1();
-
-  void problem2();
-}
-namespace day11 {
-  void problem1();
-
-  void problem2();
-}
-namespace day12 {
-  void problem1();
-
-  void problem2();
-}
-namespace day13 {
-  void problem1();
-
-  void problem2();
-}
-namespace day14 {
-  void problem1();
-
-  void problem2();
-}
-namespace day15 {
-  void problem1();
-
-  void problem2();
-}
-namespace day16 {
-  void problem1();
-
-  void problem2();
-}
-namespace day17 {
-  void problem1();
-
-  void problem2();
-}
-namespace day18 {
-  void problem1();
-
-  void problem2();
-}
-namespace day19 {
-  void problem1();
-
-  void problem2();
-}
-namespace day20 {
-  void problem1();
-
-  void problem2();
-}
-namespace day21 {
-  void problem1();
-
-  void problem2();
-}
-namespace day22 {
-  void problem1();
-
-  void problem2();
-}
-namespace day23 {
-  void problem1();
-
-  void problem2();
+  if (output_path.empty()) {
+    generate::write_input(std::cout, day, options);
+    return 0;
+  }
+  std::ofstream output_stream(output_path);
+  if (!output_stream.is_open()) {
+    std::cerr << "ERROR: Cannot open file " << output_path << "!" << std::endl;
+    return -7;
+  }
+  generate::write_input(output_stream, day, options);
+  return 0;
 }
 
 int main(int argc, char const *argv[]) {
-  std::vector<std::vector<std::function<void(void)>>> days = {
+  runner::day_problems_t days = {
     {day1::problem1,  day1::problem2},
     {day2::problem1,  day2::problem2},
     {day3::problem1,  day3::problem2},
@@ -147,23 +110,121 @@ int main(int argc, char const *argv[]) {
     {day23::problem1, day23::problem2},
   };
 
-  if (argc > 2) {
-    std::cerr << "ERROR: Specify no params or a day # to run a specific day" << std::endl;
-    return -1;
+  // Input loading only, for days whose inputs are parsed line by line. Benchmarked with --parse-only
+  runner::day_problems_t parsers(days.size());
+  parsers[4 - 1] = {[] {
+    std::vector<day4::guard_event_t> input;
+    day4::read_day4_data(input, input::resolve_path(4, "data/day4/problem1/input.txt"));
+  }};
+  parsers[7 - 1] = {[] {
+    std::vector<day7::step_rule_t> input;
+    day7::read_day7_data(input, input::resolve_path(7, "data/day7/problem1/input.txt"));
+  }};
+  parsers[10 - 1] = {[] {
+    std::vector<day10::point_of_light_t> input;
+    day10::read_day10_data(input, input::resolve_path(10, "data/day10/problem1/input.txt"));
+  }};
+  parsers[12 - 1] = {[] {
+    day12::cave_t input;
+    day12::read_day12_data(input, input::resolve_path(12, "data/day12/problem1/input.txt"));
+  }};
+  parsers[16 - 1] = {[] {
+    day16::instruction_tracer_t tracer;
+    day16::read_day16_trace_data(tracer, input::resolve_path(16, "data/day16/problem2/input_trace.txt"));
+  }};
+  parsers[17 - 1] = {[] {
+    std::vector<day17::scan_t> scans;
+    day17::read_day17_data(scans, input::resolve_path(17, "data/day17/problem1/input.txt"));
+  }};
+  parsers[23 - 1] = {[] {
+    std::vector<day23::nanobot_t> nanobots;
+    day23::read_day23_data(nanobots, input::resolve_path(23, "data/day23/problem1/input.txt"));
+  }};
+
+  const char *usage = "Usage: advent_of_code_2018 [--input DAY[:NAME]=PATH]... [--instrument] "
+                      "[--jobs N | --bench [--parse-only] [--warmup N] [--iterations N] [--format csv|json]] [day]\n"
+                      "       advent_of_code_2018 generate DAY [--size N] [--seed N] [--output PATH]";
+
+  if (argc > 1 && std::string(argv[1]) == "generate") {
+    return run_generate(argc, argv, usage);
   }
 
+  bool benchmark = false;
+  bool parse_only = false;
+  int jobs = 1;
+  bench::options_t bench_options;
   int dayToRun = -1;
-  if (argc == 2) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
     try {
-      dayToRun = std::stoi(argv[1]);
+      if (arg == "--bench") {
+        benchmark = true;
+      } else if (arg == "--parse-only") {
+        // Implies --bench
+        benchmark = true;
+        parse_only = true;
+      } else if (arg == "--instrument") {
+        instrument::enabled = true;
+      } else if (arg == "--input" && i + 1 < argc) {
+        // DAY=PATH or DAY:NAME=PATH
+        std::string value = argv[++i];
+        auto separator = value.find('=');
+        if (separator == std::string::npos || separator == 0) throw std::invalid_argument("Missing input day!");
+        auto key = value.substr(0, separator);
+        int day = std::stoi(key);
+        if (day < 1 || day > static_cast<int>(days.size())) throw std::invalid_argument("Unknown input day!");
+        auto name_separator = key.find(':');
+        key = std::to_string(day) + (name_separator == std::string::npos ? "" : key.substr(name_separator));
+        input::set_path_override(key, value.substr(separator + 1));
+      } else if (arg == "--jobs" && i + 1 < argc) {
+        jobs = std::stoi(argv[++i]);
+        // --jobs 0 means one job per hardware thread
+        if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+      } else if (arg == "--warmup" && i + 1 < argc) {
+        bench_options.warmup = std::stoi(argv[++i]);
+      } else if (arg == "--iterations" && i + 1 < argc) {
+        bench_options.iterations = std::stoi(argv[++i]);
+      } else if (arg == "--format" && i + 1 < argc) {
+        if (!bench::parse_format(argv[++i], bench_options.format)) throw std::invalid_argument("Unknown format!");
+      } else if (dayToRun == -1 && arg[0] != '-') {
+        dayToRun = std::stoi(arg);
+      } else {
+        std::cerr << "ERROR: Unknown parameter '" << arg << "'" << std::endl << usage << std::endl;
+        return -1;
+      }
     } catch (...) {
-      std::cerr << "ERROR: Invalid parameter!" << std::endl;
+      std::cerr << "ERROR: Invalid parameter!" << std::endl << usage << std::endl;
       return -2;
     }
-    if (dayToRun < 1 || dayToRun > days.size()) {
-      std::cerr << "ERROR: Day parameter is invalid!" << std::endl;
-      return -3;
-    }
+  }
+  if (dayToRun != -1 && (dayToRun < 1 || dayToRun > static_cast<int>(days.size()))) {
+    std::cerr << "ERROR: Day parameter is invalid!" << std::endl;
+    return -3;
+  }
+  if (jobs < 1) {
+    std::cerr << "ERROR: Jobs parameter is invalid!" << std::endl;
+    return -4;
+  }
+  if (bench_options.warmup < 0 || bench_options.iterations < 1) {
+    std::cerr << "ERROR: Benchmark needs warmup >= 0 and iterations >= 1!" << std::endl;
+    return -5;
+  }
+
+  if (instrument::enabled) {
+    // Summary goes to stderr at exit so stdout (results, benchmark report) stays unchanged
+    std::atexit([] { instrument::write_summary(std::cerr); });
+  }
+
+  if (benchmark) {
+    // Always serial so the problems don't compete for cores while being timed
+    auto stats = bench::run(parse_only ? parsers : days, dayToRun, bench_options);
+    bench::write_report(std::cout, stats, bench_options.format);
+    return 0;
+  }
+
+  if (jobs > 1) {
+    runner::run_parallel(days, dayToRun, jobs);
+    return 0;
   }
 
   if (dayToRun != -1) {
@@ -40,6 +40,8 @@ distribution.
 
 #include <vector>
 #include <float.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifdef _DEBUG
 	#ifndef DEBUG
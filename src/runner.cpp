@@ -0,0 +1,120 @@
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "runner.h"
+
+namespace runner {
+
+  // Output captured for the problem running on the current thread (nullptr on threads that aren't running one)
+  thread_local std::string *captured_output = nullptr;
+
+  // Installed as std::cout/std::cerr's buffer while running in parallel. Writes from a worker thread go to that
+  // worker's capture buffer; writes from any other thread pass through to the original buffer.
+  struct capture_streambuf_t : public std::streambuf {
+    std::streambuf *passthrough;
+
+    explicit capture_streambuf_t(std::streambuf *_passthrough) : passthrough(_passthrough) {}
+
+    int overflow(int c) override {
+      if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+      if (captured_output) {
+        captured_output->push_back(traits_type::to_char_type(c));
+        return c;
+      }
+      return passthrough->sputc(traits_type::to_char_type(c));
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+      if (captured_output) {
+        captured_output->append(s, static_cast<size_t>(n));
+        return n;
+      }
+      return passthrough->sputn(s, n);
+    }
+
+    int sync() override {
+      return captured_output ? 0 : passthrough->pubsync();
+    }
+  };
+
+  struct task_t {
+    std::function<void(void)> problem;
+    std::string output;
+    bool done = false;
+  };
+
+  void run_parallel(const day_problems_t &days, int day_to_run, int num_jobs) {
+    std::vector<task_t> tasks;
+    for (size_t d = 0; d < days.size(); d++) {
+      if (day_to_run != -1 && day_to_run != static_cast<int>(d) + 1) continue;
+      for (auto &problem : days[d]) {
+        tasks.push_back({problem, std::string(), false});
+      }
+    }
+
+    capture_streambuf_t cout_capture(std::cout.rdbuf());
+    capture_streambuf_t cerr_capture(std::cerr.rdbuf());
+    std::cout.rdbuf(&cout_capture);
+    std::cerr.rdbuf(&cerr_capture);
+    // Nobody can answer an interactive prompt (day 10) from inside a worker. Make it see EOF instead
+    auto cin_state = std::cin.rdstate();
+    std::cin.setstate(std::ios::failbit);
+
+    std::mutex mutex;
+    std::condition_variable task_done;
+    std::atomic<size_t> next_task{0};
+    auto worker = [&]() {
+      size_t i;
+      while ((i = next_task++) < tasks.size()) {
+        auto &task = tasks[i];
+        std::string output;
+        captured_output = &output;
+        try {
+          task.problem();
+        } catch (const std::exception &e) {
+          output += std::string("ERROR: ") + e.what() + "\n";
+        } catch (...) {
+          output += "ERROR: Problem threw an exception!\n";
+        }
+        captured_output = nullptr;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          task.output = std::move(output);
+          task.done = true;
+        }
+        task_done.notify_one();
+      }
+    };
+
+    if (static_cast<size_t>(num_jobs) > tasks.size()) num_jobs = static_cast<int>(tasks.size());
+    std::vector<std::thread> workers;
+    for (int i = 0; i < num_jobs; i++) {
+      workers.emplace_back(worker);
+    }
+
+    // Print in order while the pool keeps working
+    if (day_to_run != -1) std::cout << "Running day " << day_to_run << std::endl;
+    for (auto &task : tasks) {
+      std::string output;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        task_done.wait(lock, [&task]() { return task.done; });
+        output = std::move(task.output);
+      }
+      std::cout << output << std::endl;
+    }
+
+    for (auto &w : workers) {
+      w.join();
+    }
+
+    std::cin.clear(cin_state);
+    std::cerr.rdbuf(cerr_capture.passthrough);
+    std::cout.rdbuf(cout_capture.passthrough);
+  }
+
+}
@@ -0,0 +1,19 @@
+#ifndef ADVENT_OF_CODE_2018_RUNNER_H
+#define ADVENT_OF_CODE_2018_RUNNER_H
+
+#include <functional>
+#include <vector>
+
+namespace runner {
+
+  // days[d][p] is problem (p + 1) of day (d + 1)
+  using day_problems_t = std::vector<std::vector<std::function<void(void)>>>;
+
+  // Runs the problems of day_to_run (or of all days if day_to_run == -1) on a pool of num_jobs threads. Each
+  // problem's std::cout/std::cerr output is buffered and printed in day/problem order as soon as it and all the
+  // problems before it have finished, so the log reads the same as a serial run.
+  void run_parallel(const day_problems_t &days, int day_to_run, int num_jobs);
+
+}
+
+#endif //ADVENT_OF_CODE_2018_RUNNER_H
@@ -0,0 +1,83 @@
+#ifndef ADVENT_OF_CODE_2018_SCANNER_H
+#define ADVENT_OF_CODE_2018_SCANNER_H
+
+#include <charconv>
+#include <string_view>
+
+namespace scanner {
+
+  // Cursor over a line of puzzle input. Every method either consumes what it matched and returns true, or leaves the
+  // cursor where it was and returns false. Only single calls are atomic: a failed && chain keeps what its earlier
+  // calls matched, so wrap the chain in attempt() before trying an alternative on the same scanner.
+  // Nothing is allocated; numbers are converted in place with std::from_chars.
+  struct scanner_t {
+    std::string_view text;
+    size_t pos = 0;
+
+    explicit scanner_t(std::string_view _text) : text(_text) {}
+
+    bool done() const {
+      return pos >= text.size();
+    }
+
+    std::string_view rest() const {
+      return text.substr(pos);
+    }
+
+    void skip_whitespace() {
+      while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+        pos++;
+      }
+    }
+
+    // Consumes expected exactly
+    bool literal(std::string_view expected) {
+      if (text.compare(pos, expected.size(), expected) != 0) return false;
+      pos += expected.size();
+      return true;
+    }
+
+    // Runs pattern(*this), a chain of calls on this scanner, and moves the cursor back to where it was if it fails
+    template<typename pattern_t>
+    bool attempt(pattern_t pattern) {
+      auto start = pos;
+      if (pattern(*this)) return true;
+      pos = start;
+      return false;
+    }
+
+    // Consumes a (possibly negative) integer, skipping leading whitespace
+    template<typename T>
+    bool number(T &value) {
+      auto start = pos;
+      skip_whitespace();
+      auto result = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+      if (result.ec != std::errc()) {
+        pos = start;
+        return false;
+      }
+      pos = result.ptr - text.data();
+      return true;
+    }
+
+    // Consumes a single character if it is one of allowed
+    bool one_of(std::string_view allowed, char &c) {
+      if (done() || allowed.find(text[pos]) == std::string_view::npos) return false;
+      c = text[pos++];
+      return true;
+    }
+
+    // Consumes the longest run of characters that are all in allowed; fails on an empty run
+    bool span_of(std::string_view allowed, std::string_view &out) {
+      auto end = text.find_first_not_of(allowed, pos);
+      if (end == std::string_view::npos) end = text.size();
+      if (end == pos) return false;
+      out = text.substr(pos, end - pos);
+      pos = end;
+      return true;
+    }
+  };
+
+}
+
+#endif //ADVENT_OF_CODE_2018_SCANNER_H